@@ -0,0 +1,205 @@
+#ifdef BENCHMARK
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#include "buttons/buttonHandler.hpp"
+#include "buzzer/buzzer.hpp"
+#include "display/display.hpp"
+#include "display/transport.hpp"
+#include "tick/tick.hpp"
+#include "time/rtc.hpp"
+#include "time/time.hpp"
+#include "twi/twi.hpp"
+
+/**
+ * Program pro build flag BENCHMARK (prostředí benchmark v platformio.ini), který místo hodin změří
+ * jednotlivé horké cesty programu v simulátoru simavr, viz tools/benchmark.
+ * 
+ * Před každým měřením pošle po sériové lince řádek "B název", začátek a konec jednoho opakování
+ * označí zápisem do registru GPIOR0, na který simulátor čeká a zapíše si aktuální cyklus procesoru.
+ * Měřené funkce se volají přes ukazatel z tabulky v paměti flash, takže je překladač nemůže vložit
+ * do smyčky ani přeskládat kolem značek. Tick neběží a přerušení časovače 0 je vypnuté,
+ * měření tak ruší jen přerušení sběrnice I2C u čtení z čipu reálného času.
+ */
+#define BENCHMARK_BAUD_RATE 115200
+#define BENCHMARK_ITERATIONS 64
+#define BENCHMARK_START 0x01
+#define BENCHMARK_STOP 0x02
+#define BENCHMARK_DONE 0x03
+/**
+ * Perioda ticku v cyklech procesoru, rozpočet jednoho snímku obnovy displaye
+ */
+#define BENCHMARK_FRAME_CYCLES ((TICK_TIMER_COMPARE + 1UL) * TICK_TIMER_PRESCALER)
+
+struct Benchmark {
+    const char* name;
+    void (*prepare)(uint8_t iteration);
+    void (*run)(uint8_t iteration);
+};
+
+void benchEmpty(uint8_t) {
+}
+
+void benchSendSegments(uint8_t iteration) {
+    sendSegments(iteration, iteration % NUMBER_OF_DIGITS);
+}
+
+void benchRefreshDisplay(uint8_t) {
+    refreshDisplay();
+}
+
+void benchShowNumber(uint8_t iteration) {
+    showNumber(iteration % 10, iteration % NUMBER_OF_DIGITS);
+}
+
+void benchShowTime(uint8_t iteration) {
+    showTime(iteration % HOURS_IN_DAY, iteration % MINUTES_IN_HOUR);
+}
+
+void benchShowTimeDigits(uint8_t) {
+    showTimeDigits(getTimeDigits());
+}
+
+void benchReadPressedButtons(uint8_t) {
+    readPressedButtons();
+}
+
+/**
+ * @brief Debouncing doběhne až do ticku, ve kterém se tlačítka vyhodnotí
+ */
+void prepareButtonsTick(uint8_t) {
+    buttonsPinChanged();
+    for (uint8_t i = 1; i < DEBOUNCE_TICKS; i++) {
+        buttonsTick();
+    }
+}
+
+void benchButtonsTick(uint8_t) {
+    buttonsTick();
+}
+
+void benchTimeTick(uint8_t) {
+    timeTick();
+}
+
+/**
+ * @brief Do dalšího čtení času uplyne jedna sekunda
+ */
+void prepareGetTime(uint8_t) {
+    for (uint16_t i = 0; i < TICK_FREQUENCY; i++) {
+        timeTick();
+    }
+}
+
+void benchGetTime(uint8_t) {
+    getTime();
+}
+
+/**
+ * @brief Předchozí čtení času doběhne a vyzvedne se, další volání serviceTime začne nové
+ */
+void prepareServiceTimeResync(uint8_t) {
+    waitForTwi();
+    serviceTime();
+    requestTimeResync();
+}
+
+void benchServiceTime(uint8_t) {
+    serviceTime();
+}
+
+void benchReadRtc(uint8_t) {
+    uint8_t registers[DS3231_TIME_REGISTERS];
+    readRtcRegisters(DS3231_SECONDS_REGISTER, registers, DS3231_TIME_REGISTERS);
+}
+
+void prepareBuzzerTick(uint8_t iteration) {
+    if (iteration == 0) {
+        playPattern(PATTERN_ALARM);
+    }
+}
+
+void benchBuzzerTick(uint8_t) {
+    buzzerTick();
+}
+
+const char emptyName[] PROGMEM = "empty";
+const char sendSegmentsName[] PROGMEM = "sendSegments";
+const char refreshDisplayName[] PROGMEM = "refreshDisplay";
+const char showNumberName[] PROGMEM = "showNumber";
+const char showTimeName[] PROGMEM = "showTime";
+const char showTimeDigitsName[] PROGMEM = "showTimeDigits";
+const char readPressedButtonsName[] PROGMEM = "readPressedButtons";
+const char buttonsTickName[] PROGMEM = "buttonsTick";
+const char timeTickName[] PROGMEM = "timeTick";
+const char getTimeName[] PROGMEM = "getTime";
+const char serviceTimeResyncName[] PROGMEM = "serviceTimeResync";
+const char readRtcName[] PROGMEM = "readRtcRegisters";
+const char buzzerTickName[] PROGMEM = "buzzerTick";
+
+/**
+ * @brief Měření v pořadí, ve kterém se spustí, první je prázdné volání, které simulátor odečte od ostatních
+ */
+const Benchmark benchmarks[] PROGMEM = {
+    {emptyName, nullptr, benchEmpty},
+    {sendSegmentsName, nullptr, benchSendSegments},
+    {refreshDisplayName, nullptr, benchRefreshDisplay},
+    {showNumberName, nullptr, benchShowNumber},
+    {showTimeName, nullptr, benchShowTime},
+    {showTimeDigitsName, nullptr, benchShowTimeDigits},
+    {readPressedButtonsName, nullptr, benchReadPressedButtons},
+    {buttonsTickName, prepareButtonsTick, benchButtonsTick},
+    {timeTickName, nullptr, benchTimeTick},
+    {getTimeName, prepareGetTime, benchGetTime},
+    {serviceTimeResyncName, prepareServiceTimeResync, benchServiceTime},
+    {readRtcName, nullptr, benchReadRtc},
+    {buzzerTickName, prepareBuzzerTick, benchBuzzerTick},
+};
+
+#define NUMBER_OF_BENCHMARKS (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+/**
+ * @brief Ohlásí název měření a BENCHMARK_ITERATIONS krát změří jeho funkci
+ * Řádek se před měřením celý odešle, aby přerušení sériové linky měření nerušilo.
+ */
+void runBenchmark(const Benchmark* benchmark) {
+    void (*prepare)(uint8_t) = (void (*)(uint8_t))pgm_read_ptr(&benchmark->prepare);
+    void (*run)(uint8_t) = (void (*)(uint8_t))pgm_read_ptr(&benchmark->run);
+    Serial.print(F("B "));
+    Serial.println((const __FlashStringHelper*)pgm_read_ptr(&benchmark->name));
+    Serial.flush();
+    for (uint8_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        if (prepare != nullptr) {
+            prepare(i);
+        }
+        GPIOR0 = BENCHMARK_START;
+        run(i);
+        GPIOR0 = BENCHMARK_STOP;
+    }
+}
+
+/**
+ * @brief Spustí všechna měření, rozpočet snímku pošle jako řádek "F cykly"
+ * 
+ */
+void setup() {
+    Serial.begin(BENCHMARK_BAUD_RATE);
+    TIMSK0 = 0;
+    initDisplay();
+    initButtons();
+    initBuzzer();
+    initTime(12, 0, 0);
+    Serial.print(F("F "));
+    Serial.println(BENCHMARK_FRAME_CYCLES);
+    for (uint8_t i = 0; i < NUMBER_OF_BENCHMARKS; i++) {
+        runBenchmark(&benchmarks[i]);
+    }
+    stopBuzzer();
+    Serial.println(F("E"));
+    Serial.flush();
+    GPIOR0 = BENCHMARK_DONE;
+}
+
+void loop() {
+}
+#endif
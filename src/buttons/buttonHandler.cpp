@@ -2,60 +2,106 @@
 
 #include <Arduino.h>
 
+#include "buttons/eventQueue.hpp"
+#include "gpio/gpio.hpp"
+#include "memory/memory.hpp"
+#include "tick/tick.hpp"
+
 #define BUTTON_CLICKED 0
 
-bool timeSetBtnClicked = false;
-bool timePlusBtnClicked = false;
-bool timeMinusBtnClicked = false;
-bool alarmSetBtnClicked = false;
-bool snoozeBtnClicked = false;
+static_assert(DEBOUNCE_TICKS > 0 && DEBOUNCE_TICKS <= 255, "DEBOUNCE_MILLIS does not fit into the debounce counter");
+
+typedef GpioPin<TIME_SET_BUTTON> TimeSetButtonPin;
+typedef GpioPin<TIME_PLUS_BUTTON> TimePlusButtonPin;
+typedef GpioPin<TIME_MINUS_BUTTON> TimeMinusButtonPin;
+typedef GpioPin<ALERT_SET_BUTTON> AlertSetButtonPin;
+typedef GpioPin<SNOOZE_BUTTON> SnoozeButtonPin;
+
+/**
+ * @brief Ustálený stav tlačítek po debouncingu, bit na pozici indexu tlačítka je 1, pokud je tlačítko stisknuté
+ */
+uint8_t stableButtons = 0;
+
+/**
+ * @brief Počet ticků, po které se ještě čeká na ustálení kontaktů, 0 znamená, že se nic neděje
+ */
+volatile uint8_t debounceTicks = 0;
+
+MEMORY_FOOTPRINT(buttons, sizeof(stableButtons) + sizeof(debounceTicks));
 
 /**
  * @brief Inicializuje tlačítka a připravý je na vstupní signály
  *
  */
 void initButtons() {
-    pinMode(TIME_PLUS_BUTTON, INPUT_PULLUP);
-    pinMode(TIME_MINUS_BUTTON, INPUT_PULLUP);
-    pinMode(TIME_SET_BUTTON, INPUT_PULLUP);
-    pinMode(ALERT_SET_BUTTON, INPUT_PULLUP);
-    pinMode(SNOOZE_BUTTON, INPUT_PULLUP);
+    TimePlusButtonPin::setInputPullup();
+    TimeMinusButtonPin::setInputPullup();
+    TimeSetButtonPin::setInputPullup();
+    AlertSetButtonPin::setInputPullup();
+    SnoozeButtonPin::setInputPullup();
+    stableButtons = readPressedButtons();
+    TimePlusButtonPin::enablePinChangeInterrupt();
+    TimeMinusButtonPin::enablePinChangeInterrupt();
+    TimeSetButtonPin::enablePinChangeInterrupt();
+    AlertSetButtonPin::enablePinChangeInterrupt();
+    SnoozeButtonPin::enablePinChangeInterrupt();
 }
 
 /**
- * @brief Podívá se, jestli je dané tlačítko stisknuté a pokud ano vrátí hodnotu true, jinak vrátí hodnotu false
+ * @brief Podívá se, jestli je tlačítko na daném pinu stisknuté
  * 
- * @param button Pin, ke kterému je tlačítko připojeno
- * @param buttonStatus ukazatel na stav tlačítka v naší datové struktuře
+ * @param pinLevel Úroveň pinu, ke kterému je tlačítko připojeno
  * @return true pokud je tlačítko stisknuté
  * @return false pokud není tlačítko stisknuto
  */
-bool isButtonClicked(int button, bool* buttonStatus) {
-    bool retValue = false;
-    if (digitalRead(button) == BUTTON_CLICKED) {
-        if (!*buttonStatus) {
-            retValue = true;
-        }
-        *buttonStatus = true;
-    } else {
-        *buttonStatus = false;
-    }
-    return retValue;
+inline bool isPressed(bool pinLevel) {
+    return pinLevel == BUTTON_CLICKED;
 }
 
 /**
- * @brief Vrací stav všech tlačítek po přečtení vstupů Arduina
+ * @brief Přečte všechna tlačítka v jednom okamžiku
  * 
- * @return ButtonsStatus datová struktura obsahujíçí data o tom, která tlačítka jsou stisknuta a která nikoliv
+ * @return Bitová maska stisknutých tlačítek, bit na pozici indexu tlačítka (Buttons)
  */
+uint8_t readPressedButtons() {
+    PortSnapshot snapshot = takePortSnapshot();
+    return isPressed(TimeSetButtonPin::readFrom(snapshot)) << BUTTON_TIME_SET |
+           isPressed(TimePlusButtonPin::readFrom(snapshot)) << BUTTON_TIME_PLUS |
+           isPressed(TimeMinusButtonPin::readFrom(snapshot)) << BUTTON_TIME_MINUS |
+           isPressed(AlertSetButtonPin::readFrom(snapshot)) << BUTTON_ALARM_SET |
+           isPressed(SnoozeButtonPin::readFrom(snapshot)) << BUTTON_SNOOZE;
+}
 
-ButtonsStatus getButtonsStatus() {
-    ButtonsStatus status = {
-        .setTimeClicked = isButtonClicked(TIME_SET_BUTTON, &timeSetBtnClicked),
-        .timePlusClicked = isButtonClicked(TIME_PLUS_BUTTON, &timePlusBtnClicked),
-        .timeMinusClicked = isButtonClicked(TIME_MINUS_BUTTON, &timeMinusBtnClicked),
-        .setAlarmClicked = isButtonClicked(ALERT_SET_BUTTON, &alarmSetBtnClicked),
-        .snoozeClicked = isButtonClicked(SNOOZE_BUTTON, &snoozeBtnClicked)};
+/**
+ * @brief Některé tlačítko změnilo úroveň, volá se z přerušení při změně pinu
+ * Každá další změna (zákmit) odloží vyhodnocení o celou dobu debouncingu.
+ * 
+ */
+void buttonsPinChanged() {
+    debounceTicks = DEBOUNCE_TICKS;
+}
 
-    return status;
+/**
+ * @brief Krok debouncingu, volá se z přerušení ticku
+ * Jakmile se kontakty po DEBOUNCE_MILLIS přestanou měnit, porovná se nový stav s ustáleným
+ * a do fronty se pro každé změněné tlačítko vloží událost stisku nebo uvolnění.
+ * 
+ */
+void buttonsTick() {
+    uint8_t ticks = debounceTicks;
+    if (ticks == 0) {
+        return;
+    }
+    debounceTicks = --ticks;
+    if (ticks != 0) {
+        return;
+    }
+    uint8_t pressed = readPressedButtons();
+    uint8_t changed = pressed ^ stableButtons;
+    for (uint8_t button = 0; button < NUMBER_OF_BUTTONS; button++) {
+        if (changed & _BV(button)) {
+            pushButtonEvent(pressed & _BV(button) ? button : button | BUTTON_EVENT_RELEASED);
+        }
+    }
+    stableButtons = pressed;
 }
@@ -1,28 +1,41 @@
 #ifndef __BUTTON__HANDLER__HPP__
 #define __BUTTON__HANDLER__HPP__
+#include <Arduino.h>
+
+#include "tick/tick.hpp"
 
 #define TIME_SET_BUTTON A1
 #define TIME_PLUS_BUTTON A0
 #define TIME_MINUS_BUTTON A2
 #define ALERT_SET_BUTTON A3
+// Pin 13 je při SPI_PIN_LAYOUT obsazen hodinami SPI (SCK) registru displaye
+#ifdef SPI_PIN_LAYOUT
+#define SNOOZE_BUTTON 4
+#else
 #define SNOOZE_BUTTON 13
+#endif
 
 /**
- * Datová struktura na udržení stavu tlačítek použitých v projektu
+ * Doba, po kterou se kontakty tlačítka nesmí změnit, aby se změna uznala
  */
+#define DEBOUNCE_MILLIS 20
+#define DEBOUNCE_TICKS MILLIS_TO_TICKS(DEBOUNCE_MILLIS)
 
-struct ButtonsStatus{
-    bool setTimeClicked;
-    bool timePlusClicked;
-    bool timeMinusClicked;
-    bool setAlarmClicked;
-    bool snoozeClicked;
+/**
+ * Indexy tlačítek v bitové masce stisknutých tlačítek a v událostech tlačítek
+ */
+enum Buttons {
+    BUTTON_TIME_SET,
+    BUTTON_TIME_PLUS,
+    BUTTON_TIME_MINUS,
+    BUTTON_ALARM_SET,
+    BUTTON_SNOOZE,
+    NUMBER_OF_BUTTONS
 };
 
-
-
 void initButtons();
-bool isButtonClicked(int button, bool * buttonStatus);
-ButtonsStatus getButtonsStatus();
+uint8_t readPressedButtons();
+void buttonsPinChanged();
+void buttonsTick();
 
 #endif
\ No newline at end of file
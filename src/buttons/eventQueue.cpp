@@ -0,0 +1,52 @@
+#include "eventQueue.hpp"
+
+#include <Arduino.h>
+
+#include "memory/memory.hpp"
+
+/**
+ * @brief Kruhová fronta událostí tlačítek s jedním producentem (přerušení ticku) a jedním konzumentem (hlavní smyčka)
+ * Zápis hlavy provádí jen producent a zápis konce jen konzument. Oba indexy mají jeden bajt,
+ * takže se na AVR čtou i zapisují atomicky a fronta nepotřebuje vypínat přerušení.
+ * Buffer je volatile, aby překladač nepřesunul čtení události před kontrolu hlavy.
+ */
+volatile uint8_t buttonEvents[BUTTON_EVENT_QUEUE_SIZE];
+volatile uint8_t buttonEventsHead = 0;
+volatile uint8_t buttonEventsTail = 0;
+
+MEMORY_FOOTPRINT(events, sizeof(buttonEvents) + sizeof(buttonEventsHead) + sizeof(buttonEventsTail));
+
+/**
+ * @brief Vloží událost na konec fronty, volá se pouze z přerušení
+ * 
+ * @param event Událost tlačítka
+ * @return true Pokud se událost vešla
+ * @return false Pokud je fronta plná a událost se zahodila
+ */
+bool pushButtonEvent(uint8_t event) {
+    uint8_t head = buttonEventsHead;
+    uint8_t next = (head + 1) & BUTTON_EVENT_QUEUE_MASK;
+    if (next == buttonEventsTail) {
+        return false;
+    }
+    buttonEvents[head] = event;
+    buttonEventsHead = next;
+    return true;
+}
+
+/**
+ * @brief Vyjme nejstarší událost z fronty, volá se pouze z hlavní smyčky
+ * 
+ * @param event Kam se událost uloží
+ * @return true Pokud fronta obsahovala událost
+ * @return false Pokud je fronta prázdná
+ */
+bool popButtonEvent(uint8_t* event) {
+    uint8_t tail = buttonEventsTail;
+    if (tail == buttonEventsHead) {
+        return false;
+    }
+    *event = buttonEvents[tail];
+    buttonEventsTail = (tail + 1) & BUTTON_EVENT_QUEUE_MASK;
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef __EVENT__QUEUE__HPP__
+#define __EVENT__QUEUE__HPP__
+#include <Arduino.h>
+
+/**
+ * Velikost fronty událostí tlačítek, musí být mocnina dvou
+ */
+#define BUTTON_EVENT_QUEUE_SIZE 8
+#define BUTTON_EVENT_QUEUE_MASK (BUTTON_EVENT_QUEUE_SIZE - 1)
+
+static_assert((BUTTON_EVENT_QUEUE_SIZE & BUTTON_EVENT_QUEUE_MASK) == 0, "BUTTON_EVENT_QUEUE_SIZE has to be a power of two");
+
+/**
+ * Událost tlačítka, dolní bity jsou index tlačítka, horní bit značí uvolnění
+ */
+#define BUTTON_EVENT_RELEASED 0x80
+#define BUTTON_EVENT_BUTTON_MASK 0x07
+
+bool pushButtonEvent(uint8_t event);
+bool popButtonEvent(uint8_t* event);
+
+#endif
@@ -0,0 +1,147 @@
+#include "gestures.hpp"
+
+#include <Arduino.h>
+
+#include "buttons/eventQueue.hpp"
+#include "memory/memory.hpp"
+#include "trace/trace.hpp"
+
+/**
+ * @brief Tlačítka, která opakují, tlačítka, která kliknou až při uvolnění, a tlačítka akordu
+ */
+#define REPEAT_BUTTONS (_BV(BUTTON_TIME_PLUS) | _BV(BUTTON_TIME_MINUS))
+#define LONG_PRESS_BUTTONS (_BV(BUTTON_TIME_SET) | _BV(BUTTON_ALARM_SET))
+#define CHORD_BUTTONS (_BV(BUTTON_TIME_SET) | _BV(BUTTON_ALARM_SET))
+#define NO_HOLD 0xFF
+
+/**
+ * @brief Stisknutá tlačítka podle událostí z fronty a tlačítko, jehož držení se měří
+ * holdMillis je čas stisku, po prvním opakování čas posledního opakování.
+ */
+uint8_t heldButtons = 0;
+uint8_t holdButton = NO_HOLD;
+unsigned long holdMillis = 0;
+uint8_t repeats = 0;
+/**
+ * @brief Tlačítka, která už dala dlouhý stisk nebo akord, nebo je během držení přerušil jiný stisk, jejich uvolnění neklikne
+ */
+uint8_t takenButtons = 0;
+
+MEMORY_FOOTPRINT(gestures, sizeof(heldButtons) + sizeof(holdButton) + sizeof(holdMillis) + sizeof(repeats) +
+                 sizeof(takenButtons));
+
+/**
+ * @brief Začne měřit držení tlačítka
+ *
+ * @param button Index tlačítka
+ */
+void armHold(uint8_t button) {
+    holdButton = button;
+    holdMillis = millis();
+    repeats = 0;
+}
+
+/**
+ * @brief Po uvolnění měřeného tlačítka začne znovu měřit držení opakujícího tlačítka, které zůstalo stisknuté
+ * Například TIME+ po krátkém ťuknutí na TIME- pokračuje v opakování.
+ */
+void rearmHold() {
+    holdButton = NO_HOLD;
+    for (uint8_t button = 0; button < NUMBER_OF_BUTTONS; button++) {
+        if (heldButtons & REPEAT_BUTTONS & _BV(button)) {
+            armHold(button);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Zpracuje událost tlačítka z fronty
+ *
+ * @param event Událost tlačítka
+ * @param gesture Kam se zapíše gesto
+ * @return true Pokud událost dala gesto
+ */
+bool buttonEventToGesture(uint8_t event, uint8_t* gesture) {
+    uint8_t button = event & BUTTON_EVENT_BUTTON_MASK;
+    if (event & BUTTON_EVENT_RELEASED) {
+        heldButtons &= ~_BV(button);
+        if (button == holdButton || holdButton == NO_HOLD) {
+            rearmHold();
+        }
+        bool click = (_BV(button) & LONG_PRESS_BUTTONS & ~takenButtons) != 0;
+        takenButtons &= ~_BV(button);
+        *gesture = button;
+        return click;
+    }
+    // druhý stisk, který nedává akord, zruší dlouhý stisk držených tlačítek i jejich kliknutí
+    takenButtons |= heldButtons & LONG_PRESS_BUTTONS;
+    heldButtons |= _BV(button);
+    if ((heldButtons & CHORD_BUTTONS) == CHORD_BUTTONS) {
+        holdButton = NO_HOLD;
+        takenButtons |= CHORD_BUTTONS;
+        *gesture = GESTURE_CHORD;
+        return true;
+    }
+    if (_BV(button) & (REPEAT_BUTTONS | LONG_PRESS_BUTTONS)) {
+        armHold(button);
+    } else if (holdButton != NO_HOLD && (_BV(holdButton) & LONG_PRESS_BUTTONS)) {
+        holdButton = NO_HOLD;
+    }
+    *gesture = button;
+    return !(_BV(button) & LONG_PRESS_BUTTONS);
+}
+
+/**
+ * @brief Zjistí, zdali držené tlačítko nemá opakovat nebo dát dlouhý stisk
+ *
+ * @param gesture Kam se zapíše gesto
+ * @return true Pokud držení dalo gesto
+ */
+bool holdToGesture(uint8_t* gesture) {
+    if (holdButton == NO_HOLD) {
+        return false;
+    }
+    unsigned long held = millis() - holdMillis;
+    if (_BV(holdButton) & LONG_PRESS_BUTTONS) {
+        if (held < LONG_PRESS_MILLIS) {
+            return false;
+        }
+        takenButtons |= _BV(holdButton);
+        holdButton = NO_HOLD;
+        *gesture = GESTURE_LONG_PRESS;
+        return true;
+    }
+    if (held < (repeats == 0 ? REPEAT_DELAY_MILLIS : REPEAT_PERIOD_MILLIS)) {
+        return false;
+    }
+    holdMillis = millis();
+    if (repeats <= REPEATS_BEFORE_FAST) {
+        repeats++;
+    }
+    bool fast = repeats > REPEATS_BEFORE_FAST;
+    if (holdButton == BUTTON_TIME_PLUS) {
+        *gesture = fast ? GESTURE_PLUS_FAST : GESTURE_PLUS_REPEAT;
+    } else {
+        *gesture = fast ? GESTURE_MINUS_FAST : GESTURE_MINUS_REPEAT;
+    }
+    return true;
+}
+
+/**
+ * @brief Vrátí další gesto, nejdřív z událostí ve frontě, pak z držených tlačítek, volá se pouze z hlavní smyčky
+ * Každá událost z fronty se zapíše do záznamu událostí.
+ *
+ * @param gesture Kam se zapíše gesto z Gestures
+ * @return false Pokud žádné gesto nenastalo
+ */
+bool popGesture(uint8_t* gesture) {
+    uint8_t event;
+    while (popButtonEvent(&event)) {
+        traceEvent(TRACE_BUTTON, event, 0, 0);
+        if (buttonEventToGesture(event, gesture)) {
+            return true;
+        }
+    }
+    return holdToGesture(gesture);
+}
@@ -0,0 +1,36 @@
+#ifndef __GESTURES__HPP__
+#define __GESTURES__HPP__
+#include <Arduino.h>
+
+#include "buttons/buttonHandler.hpp"
+
+/**
+ * Gesta tlačítek složená z událostí stisku a uvolnění ve frontě, vyhodnocují se v hlavní smyčce:
+ * - TIME+, TIME- a SNOOZE kliknou hned při stisku, TIME+ a TIME- po REPEAT_DELAY_MILLIS držení opakují
+ *   každých REPEAT_PERIOD_MILLIS a po REPEATS_BEFORE_FAST opakováních přejdou na rychlé kroky
+ * - TIME_SET a ALARM_SET kliknou až při uvolnění, držené déle než LONG_PRESS_MILLIS dají dlouhý stisk
+ * - TIME_SET a ALARM_SET stisknuté zároveň dají akord, po dlouhém stisku ani akordu uvolnění nekliká
+ * - jiné tlačítko stisknuté během držení TIME_SET nebo ALARM_SET dlouhý stisk i kliknutí zruší,
+ *   po uvolnění tlačítka, které opakovalo nebo mělo dát dlouhý stisk, pokračuje v opakování stále držené TIME+ nebo TIME-
+ */
+#define LONG_PRESS_MILLIS 1000
+#define REPEAT_DELAY_MILLIS 500
+#define REPEAT_PERIOD_MILLIS 200
+#define REPEATS_BEFORE_FAST 5
+
+/**
+ * Gesta, kliknutí tlačítka má stejný index jako tlačítko v Buttons
+ */
+enum Gestures {
+    GESTURE_PLUS_REPEAT = NUMBER_OF_BUTTONS,
+    GESTURE_MINUS_REPEAT,
+    GESTURE_PLUS_FAST,
+    GESTURE_MINUS_FAST,
+    GESTURE_LONG_PRESS,
+    GESTURE_CHORD,
+    NUMBER_OF_GESTURES
+};
+
+bool popGesture(uint8_t* gesture);
+
+#endif
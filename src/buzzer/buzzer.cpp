@@ -0,0 +1,145 @@
+#include "buzzer.hpp"
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#include "gpio/gpio.hpp"
+#include "memory/memory.hpp"
+#include "tick/tick.hpp"
+
+typedef GpioPin<ALARM_PIN> BuzzerPin;
+
+#define BUZZER_STEP_TICKS MILLIS_TO_TICKS(BUZZER_STEP_MILLIS)
+
+/**
+ * @brief Dvojité pípnutí s pauzou a na plné hlasitosti rychlé čtyřnásobné pípání
+ */
+const uint8_t alarmPattern[] PROGMEM = {
+    BUZZER_STEP(true, 100), BUZZER_STEP(false, 100), BUZZER_STEP(true, 100), BUZZER_STEP(false, 700),
+    BUZZER_END};
+const uint8_t urgentPattern[] PROGMEM = {
+    BUZZER_STEP(true, 60), BUZZER_STEP(false, 60), BUZZER_STEP(true, 60), BUZZER_STEP(false, 60),
+    BUZZER_STEP(true, 60), BUZZER_STEP(false, 60), BUZZER_STEP(true, 60), BUZZER_STEP(false, 300),
+    BUZZER_END};
+
+/**
+ * @brief Vzory indexované BuzzerPattern
+ */
+const uint8_t* const patterns[NUMBER_OF_PATTERNS] PROGMEM = {alarmPattern, urgentPattern};
+
+/**
+ * @brief Stav přehrávání, mění ho jen tick, hlavní smyčka jen se zakázanými přerušeními
+ */
+volatile bool playing = false;
+uint8_t currentPattern;
+const uint8_t* nextStep;
+uint16_t stepTicks;
+bool stepOn;
+uint8_t duty;
+uint8_t dutyPhase;
+uint16_t buzzerSecondTicks;
+uint16_t playedSeconds;
+
+MEMORY_FOOTPRINT(buzzer, sizeof(playing) + sizeof(currentPattern) + sizeof(nextStep) + sizeof(stepTicks) +
+                 sizeof(stepOn) + sizeof(duty) + sizeof(dutyPhase) + sizeof(buzzerSecondTicks) +
+                 sizeof(playedSeconds));
+
+/**
+ * @brief Nastaví pin bzučáku jako výstup, bzučák mlčí
+ * 
+ */
+void initBuzzer() {
+    BuzzerPin::low();
+    BuzzerPin::setOutput();
+}
+
+/**
+ * @brief Načte další krok vzoru, na konci vzoru pokračuje od začátku
+ */
+void loadStep() {
+    uint8_t step = pgm_read_byte(nextStep);
+    if (step == BUZZER_END) {
+        nextStep = (const uint8_t*)pgm_read_ptr(&patterns[currentPattern]);
+        step = pgm_read_byte(nextStep);
+    }
+    nextStep++;
+    stepOn = step & BUZZER_STEP_ON;
+    stepTicks = (step & ~BUZZER_STEP_ON) * BUZZER_STEP_TICKS;
+}
+
+/**
+ * @brief Začne od začátku přehrávat vzor
+ */
+void startPattern(uint8_t pattern) {
+    currentPattern = pattern;
+    nextStep = (const uint8_t*)pgm_read_ptr(&patterns[pattern]);
+    loadStep();
+}
+
+/**
+ * @brief Začne přehrávat vzor potichu, dál ho už obsluhuje jen tick
+ * 
+ * @param pattern Vzor (BuzzerPattern)
+ */
+void playPattern(uint8_t pattern) {
+    noInterrupts();
+    startPattern(pattern);
+    duty = BUZZER_START_DUTY;
+    dutyPhase = 0;
+    buzzerSecondTicks = 0;
+    playedSeconds = 0;
+    playing = true;
+    interrupts();
+}
+
+/**
+ * @brief Okamžitě umlčí bzučák
+ * 
+ */
+void stopBuzzer() {
+    noInterrupts();
+    playing = false;
+    BuzzerPin::low();
+    interrupts();
+}
+
+/**
+ * @brief Zjistí, zdali bzučák přehrává vzor, po vypršení BUZZER_TIMEOUT_SECONDS už ne
+ */
+bool isBuzzerPlaying() {
+    return playing;
+}
+
+/**
+ * @brief Volá se z ticku, posune vzor, spíná bzučák podle střídy a hlídá zesilování a vypršení alarmu
+ * 
+ */
+void buzzerTick() {
+    if (!playing) {
+        return;
+    }
+    if (++buzzerSecondTicks >= TICK_FREQUENCY) {
+        buzzerSecondTicks = 0;
+        playedSeconds++;
+        if (playedSeconds >= BUZZER_TIMEOUT_SECONDS) {
+            playing = false;
+            BuzzerPin::low();
+            return;
+        }
+        if (playedSeconds % BUZZER_ESCALATION_SECONDS == 0 && duty < BUZZER_DUTY_STEPS) {
+            duty++;
+            if (duty == BUZZER_DUTY_STEPS && currentPattern == PATTERN_ALARM) {
+                startPattern(PATTERN_ALARM_URGENT);
+            }
+        }
+    }
+    if (--stepTicks == 0) {
+        loadStep();
+    }
+    dutyPhase = dutyPhase + 1 < BUZZER_DUTY_STEPS ? dutyPhase + 1 : 0;
+    if (stepOn && dutyPhase < duty) {
+        BuzzerPin::high();
+    } else {
+        BuzzerPin::low();
+    }
+}
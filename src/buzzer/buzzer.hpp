@@ -0,0 +1,42 @@
+#ifndef __BUZZER__HPP__
+#define __BUZZER__HPP__
+#include <Arduino.h>
+
+#define ALARM_PIN 7
+
+/**
+ * Vzor pípání je v paměti flash jako posloupnost kroků, jeden bajt na krok: horní bit říká, zdali bzučák v kroku zní,
+ * zbytek je délka kroku v násobcích BUZZER_STEP_MILLIS. Bajt 0 vzor ukončí a vzor se přehrává znovu od začátku.
+ */
+#define BUZZER_STEP_MILLIS 10
+#define BUZZER_STEP_ON 0x80
+#define BUZZER_STEP(on, millis) (((on) ? BUZZER_STEP_ON : 0) | ((millis) / BUZZER_STEP_MILLIS))
+#define BUZZER_END 0
+
+/**
+ * Hlasitost je střída, se kterou bzučák během znějícího kroku spíná, v ticích z periody BUZZER_DUTY_STEPS ticků.
+ * Alarm začíná potichu a každých BUZZER_ESCALATION_SECONDS sekund zesílí, na plné hlasitosti přejde na rychlejší vzor.
+ * Po BUZZER_TIMEOUT_SECONDS sekundách alarm sám utichne.
+ */
+#define BUZZER_DUTY_STEPS 8
+#define BUZZER_START_DUTY 2
+#ifndef BUZZER_ESCALATION_SECONDS
+#define BUZZER_ESCALATION_SECONDS 10
+#endif
+#ifndef BUZZER_TIMEOUT_SECONDS
+#define BUZZER_TIMEOUT_SECONDS 300
+#endif
+
+enum BuzzerPattern {
+    PATTERN_ALARM,
+    PATTERN_ALARM_URGENT,
+    NUMBER_OF_PATTERNS
+};
+
+void initBuzzer();
+void playPattern(uint8_t pattern);
+void stopBuzzer();
+bool isBuzzerPlaying();
+void buzzerTick();
+
+#endif
@@ -0,0 +1,33 @@
+#include "crc.hpp"
+
+#include <Arduino.h>
+
+/**
+ * @brief Přidá jeden bajt do CRC-8 (polynom 0x31, stejný jako u čipů Dallas/Maxim)
+ * 
+ * @param crc Dosavadní hodnota CRC
+ * @param data Přidávaný bajt
+ * @return Nová hodnota CRC
+ */
+uint8_t crc8Update(uint8_t crc, uint8_t data) {
+    crc ^= data;
+    for (uint8_t i = 0; i < 8; i++) {
+        crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
+    }
+    return crc;
+}
+
+/**
+ * @brief Spočítá CRC-8 bloku dat
+ * 
+ * @param data Data
+ * @param length Počet bajtů
+ * @return Hodnota CRC
+ */
+uint8_t crc8(const uint8_t* data, uint8_t length) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        crc = crc8Update(crc, data[i]);
+    }
+    return crc;
+}
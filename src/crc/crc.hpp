@@ -0,0 +1,8 @@
+#ifndef __CRC__HPP__
+#define __CRC__HPP__
+#include <Arduino.h>
+
+uint8_t crc8Update(uint8_t crc, uint8_t data);
+uint8_t crc8(const uint8_t* data, uint8_t length);
+
+#endif
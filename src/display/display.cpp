@@ -1,6 +1,14 @@
 #include "display.hpp"
 
 #include <Arduino.h>
+
+#include "display/font.hpp"
+#include "display/transport.hpp"
+#include "gpio/gpio.hpp"
+#include "memory/memory.hpp"
+#include "tick/tick.hpp"
+
+static_assert(TICK_TIMER_COMPARE + 1 >= 2 * BRIGHTNESS_LEVELS, "REFRESH_RATE is too high for BRIGHTNESS_LEVELS");
 /**
  * @brief Indexy jednotlivých číslic v číslicových displayích, které jsou umístěny na desce
  * 
@@ -15,60 +23,189 @@ enum digits {
  * @brief Piny pro jednotlivé číslice 
  * 
  */
-uint8_t digitsPins[] = {9, 10, 5, 6};
+typedef GpioPin<HOURS_FIRST_DIGIT_PIN> HoursFirstDigitPin;
+typedef GpioPin<HOURS_SECOND_DIGIT_PIN> HoursSecondDigitPin;
+typedef GpioPin<MINUTES_FIRST_DIGIT_PIN> MinutesFirstDigitPin;
+typedef GpioPin<MINUTES_SECOND_DIGIT_PIN> MinutesSecondDigitPin;
+typedef GpioPin<DOTS_PIN> DotsPin;
 /**
- * @brief Zapnuté bity pro jednotlivé číslice pro jejich zobrazení na displayi
- * 
+ * @brief Předpočítané bajty segmentů pro jednotlivé číslice, bit 0 je segment A, bit 6 segment G a bit 7 tečka
+ * Zapisuje do něj hlavní smyčka, přerušení ticku z něj pouze čte
  */
-uint8_t numbers[NUMBER_OF_NUMBERS][NUMBER_OF_SEGMENTS] = {
-    {1, 1, 1, 1, 1, 1, 0},  // 0
-    {0, 1, 1, 0, 0, 0, 0},  // 1
-    {1, 1, 0, 1, 1, 0, 1},  // 2
-    {1, 1, 1, 1, 0, 0, 1},  // 3
-    {0, 1, 1, 0, 0, 1, 1},  // 4
-    {1, 0, 1, 1, 0, 1, 1},  // 5
-    {1, 0, 1, 1, 1, 1, 1},  // 6
-    {1, 1, 1, 0, 0, 0, 0},  // 7
-    {1, 1, 1, 1, 1, 1, 1},  // 8
-    {1, 1, 1, 1, 0, 1, 1}   // 9
-};
+volatile uint8_t frameBuffer[NUMBER_OF_DIGITS];
 
 /**
- * @brief Znak pro vypnutý alarm při jeho nastavování
- * 
+ * @brief Index číslice, kterou přerušení rozsvítí jako další
+ */
+volatile uint8_t scannedDigit = 0;
+
+/**
+ * @brief Logická hodnota, zdali se má display rozsvěcet, vypnutý display nechává frame buffer beze změny
  */
-uint8_t alarmTurnedOffSign[] = {0, 0, 0, 0, 0, 0, 1}; // -
+volatile bool displayEnabled = true;
+
+/**
+ * @brief Logická hodnota, zdali má svítit dvojtečka, přerušení ji podle ní rozsvěcí na začátku každého slotu
+ */
+volatile bool dotsLit = false;
+
+/**
+ * @brief Aktuální úroveň jasu od 1 do MAX_BRIGHTNESS
+ */
+uint8_t brightness = MAX_BRIGHTNESS;
+
+MEMORY_FOOTPRINT(display, sizeof(frameBuffer) + sizeof(scannedDigit) + sizeof(displayEnabled) + sizeof(dotsLit) +
+                 sizeof(brightness));
+
 /**
  * @brief Inicializuje display hodin
  * 
  */
 void initDisplay() {
-    pinMode(RCLK, OUTPUT);
-    pinMode(SRCLK, OUTPUT);
-    pinMode(SER, OUTPUT);
-    pinMode(DOTS_PIN, OUTPUT);
+    DotsPin::setOutput();
+    HoursFirstDigitPin::setOutput();
+    HoursSecondDigitPin::setOutput();
+    MinutesFirstDigitPin::setOutput();
+    MinutesSecondDigitPin::setOutput();
     for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
-        pinMode(digitsPins[i], OUTPUT);
+        frameBuffer[i] = 0;
     }
+    initDisplayTransport();
 }
 /**
  * @brief Vypne všechny číslice
  * 
  */
 void turnOffAllDigits() {
-    for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
-        digitalWrite(digitsPins[i], LOW);
+    HoursFirstDigitPin::low();
+    HoursSecondDigitPin::low();
+    MinutesFirstDigitPin::low();
+    MinutesSecondDigitPin::low();
+}
+
+/**
+ * @brief Rozsvítí požadovanou číslici
+ * 
+ * @param digit Index číslice od 0 do 3
+ */
+void turnOnDigit(uint8_t digit) {
+    switch (digit) {
+        case HOURS_FIRST_DIGIT:
+            HoursFirstDigitPin::high();
+            break;
+        case HOURS_SECOND_DIGIT:
+            HoursSecondDigitPin::high();
+            break;
+        case MINUTES_FIRST_DIGIT:
+            MinutesFirstDigitPin::high();
+            break;
+        case MINUTES_SECOND_DIGIT:
+            MinutesSecondDigitPin::high();
+            break;
+    }
+}
+/**
+ * @brief Krok obnovy displaye, při každém zavolání zhasne předchozí číslici a rozsvítí další z frame bufferu
+ * Volá se z přerušení časovače ticku, viz tick/tick.cpp
+ * 
+ */
+void refreshDisplay() {
+    if (!displayEnabled) {
+        turnOffAllDigits();
+        return;
+    }
+    uint8_t digit = scannedDigit;
+    DotsPin::write(dotsLit);
+    sendSegments(frameBuffer[digit], digit);
+    scannedDigit = digit + 1 < NUMBER_OF_DIGITS ? digit + 1 : 0;
+}
+
+/**
+ * @brief Zhasne číslici i dvojtečku do začátku dalšího slotu, volá se z přerušení ticku při sníženém jasu
+ * 
+ */
+void blankDisplay() {
+    turnOffAllDigits();
+    DotsPin::low();
+}
+
+/**
+ * @brief Nastaví jas displaye, číslice pak svítí jen level / BRIGHTNESS_LEVELS ze svého slotu
+ * 
+ * @param level Úroveň jasu od 1 do MAX_BRIGHTNESS
+ */
+void setBrightness(uint8_t level) {
+    if (level == 0) {
+        level = 1;
+    } else if (level > MAX_BRIGHTNESS) {
+        level = MAX_BRIGHTNESS;
+    }
+    if (level == brightness) {
+        return;
+    }
+    brightness = level;
+    if (level == MAX_BRIGHTNESS) {
+        setTickBlanking(0);
+    } else {
+        setTickBlanking((uint16_t)(TICK_TIMER_COMPARE + 1) * level / BRIGHTNESS_LEVELS - 1);
+    }
+}
+
+/**
+ * @brief Vrátí aktuální úroveň jasu
+ * @return Úroveň jasu od 1 do MAX_BRIGHTNESS
+ */
+uint8_t getBrightness() {
+    return brightness;
+}
+
+/**
+ * @brief Vrátí jas, který má display v daný čas mít, bez build flagu NIGHT_DIMMING je to vždy plný jas
+ * 
+ * @param time Aktuální čas
+ * @return Úroveň jasu od 1 do MAX_BRIGHTNESS
+ */
+uint8_t brightnessForTime(Time time) {
+#ifdef NIGHT_DIMMING
+    if (isTimeBetweenHours(time, NIGHT_DIMMING_START_HOUR, NIGHT_DIMMING_END_HOUR)) {
+        return NIGHT_BRIGHTNESS;
     }
+#else
+    (void)time;
+#endif
+    return MAX_BRIGHTNESS;
 }
+
 /**
- * @brief Posune bit do registru SN74HC595, který udržuje informace o tom, co se má ukázat na displayi
+ * @brief Zapne nebo vypne celý display včetně dvojtečky, obsah frame bufferu zůstane zachován
  * 
- * @param value 
+ * @param enabled True pokud má display svítit
  */
-void shiftBit(uint8_t value) {
-    digitalWrite(SRCLK, LOW);
-    digitalWrite(SER, value);
-    digitalWrite(SRCLK, HIGH);
+void setDisplayEnabled(bool enabled) {
+    displayEnabled = enabled;
+    if (!enabled) {
+        turnOffAllDigits();
+        turnOffDots();
+    }
+}
+
+/**
+ * @brief Zapíše bajt segmentů do frame bufferu, na displayi se objeví při nejbližší obnově
+ * 
+ * @param segments Bajt segmentů, bit 0 je segment A
+ * @param digit Index číslice od 0 do 3
+ */
+void setDigitSegments(uint8_t segments, uint8_t digit) {
+    frameBuffer[digit] = segments;
+}
+
+/**
+ * @brief Zhasne požadovanou číslici, číslice si přesto ponechá svůj čas v obnově displaye
+ * 
+ * @param digit Index číslice od 0 do 3
+ */
+void clearDigit(uint8_t digit) {
+    frameBuffer[digit] = 0;
 }
 
 /**
@@ -78,14 +215,34 @@ void shiftBit(uint8_t value) {
  * @param digit Index displaye, který chceme použít pro zobrazení čísla
  */
 void showNumber(uint8_t number, uint8_t digit) {
-    turnOffAllDigits();
-    digitalWrite(RCLK, LOW);
-    shiftBit(0);  // point should be turned off
-    for (int i = NUMBER_OF_SEGMENTS - 1; i >= 0; i--) {
-        shiftBit(numbers[number][i]);
+    setDigitSegments(digitSegments(number), digit);
+}
+
+/**
+ * @brief Zobrazí znak z fontu na požadovaném číslicovém displayi od 0 do 3
+ * 
+ * @param character ASCII znak, který chceme zobrazit
+ * @param digit Index displaye, který chceme použít pro zobrazení znaku
+ */
+void showChar(char character, uint8_t digit) {
+    setDigitSegments(glyphSegments(character), digit);
+}
+
+/**
+ * @brief Zobrazí text uložený ve flash paměti, např. showFlashText(PSTR("Err"))
+ * 
+ * @param text Text ve flash paměti ukončený nulou
+ */
+void showFlashText(const char* text) {
+    for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
+        char character = pgm_read_byte(text);
+        if (character != '\0') {
+            showChar(character, i);
+            text++;
+        } else {
+            clearDigit(i);
+        }
     }
-    digitalWrite(RCLK, HIGH);
-    digitalWrite(digitsPins[digit], HIGH);
 }
 
 /**
@@ -93,12 +250,51 @@ void showNumber(uint8_t number, uint8_t digit) {
  * 
  * @param hours Hodina, kterou chceme zobrazit
  * @param minutes Minuta, kterou chceme zobrazit
- * @param digitDelay Délka svitu jedné číslice
  */
-void showTime(uint8_t hours, uint8_t minutes, uint16_t digitDelay) {
-    showHours(hours, digitDelay);
-    showMinutes(minutes, digitDelay);
-    turnOffAllDigits();
+void showTime(uint8_t hours, uint8_t minutes) {
+    showHours(hours);
+    showMinutes(minutes);
+}
+
+/**
+ * @brief Zobrazí čas z již rozložených číslic, nepotřebuje dělení
+ * 
+ * @param digits Číslice hodin a minut
+ */
+void showTimeDigits(TimeDigits digits) {
+    if (digits.hoursTens != 0) {
+        showNumber(digits.hoursTens, HOURS_FIRST_DIGIT);
+    } else {
+        clearDigit(HOURS_FIRST_DIGIT);
+    }
+    showNumber(digits.hoursOnes, HOURS_SECOND_DIGIT);
+    showNumber(digits.minsTens, MINUTES_FIRST_DIGIT);
+    showNumber(digits.minsOnes, MINUTES_SECOND_DIGIT);
+}
+
+/**
+ * @brief Zobrazí teplotu zaokrouhlenou na celé stupně, např. "23*C" nebo "-5*C", '*' je symbol stupně
+ * Pod -9 °C se kvůli znaménku nevejde "C" a zobrazí se jen "-12*".
+ * 
+ * @param quarterDegrees Teplota ve čtvrtinách °C, čip měří od -40 do 85 °C
+ */
+void showTemperature(int16_t quarterDegrees) {
+    int16_t degrees = (quarterDegrees + 2) >> 2;
+    uint8_t digit = 0;
+    if (degrees < 0) {
+        showChar('-', digit++);
+        degrees = -degrees;
+    }
+    if (degrees >= 10) {
+        showNumber(degrees / 10 % 10, digit++);
+    } else if (digit == 0) {
+        clearDigit(digit++);
+    }
+    showNumber(degrees % 10, digit++);
+    showChar('*', digit++);
+    if (digit < NUMBER_OF_DIGITS) {
+        showChar('C', digit);
+    }
 }
 
 /**
@@ -107,7 +303,8 @@ void showTime(uint8_t hours, uint8_t minutes, uint16_t digitDelay) {
  * @param seconds aktuální sekundy
  */
 void blinkWithDots(uint8_t seconds) {
-    digitalWrite(DOTS_PIN, seconds % 2 == 0);
+    dotsLit = displayEnabled && seconds % 2 == 0;
+    DotsPin::write(dotsLit);
 }
 
 /**
@@ -115,36 +312,32 @@ void blinkWithDots(uint8_t seconds) {
  * 
  */
 void turnOffDots() {
-    digitalWrite(DOTS_PIN, LOW);
+    dotsLit = false;
+    DotsPin::low();
 }
 /**
  * @brief Zobrazí hodinu předanou jako parametr hours na prvních 2 číslicích displaye
  * 
  * @param hours Hodina, která se zobrazí na prvních 2 displayích
- * @param digitDelay Délka zobrazení jednotlivých číslic
  */
-void showHours(uint8_t hours, uint16_t digitDelay) {
+void showHours(uint8_t hours) {
     uint8_t hoursFirstDigit = hours / 10;
     if (hoursFirstDigit != 0) {
         showNumber(hoursFirstDigit, HOURS_FIRST_DIGIT);
-        delay(digitDelay);
+    } else {
+        clearDigit(HOURS_FIRST_DIGIT);
     }
     showNumber(hours % 10, HOURS_SECOND_DIGIT);
-    delay(digitDelay);
 }
 /**
  * @brief Zobrazí minuty předané jako parametr minutes na posledních 2 číslicích displaye
  * 
  * @param minutes Minuty, které se zobrazí na posledních 2 číslicích displaye
- * @param digitDelay Délka zobrazení jednotlivých číslic
  */
 
-void showMinutes(uint8_t minutes, uint16_t digitDelay) {
-    uint8_t minutesFirstDigit = minutes / 10;
-    showNumber(minutesFirstDigit, MINUTES_FIRST_DIGIT);
-    delay(digitDelay);
+void showMinutes(uint8_t minutes) {
+    showNumber(minutes / 10, MINUTES_FIRST_DIGIT);
     showNumber(minutes % 10, MINUTES_SECOND_DIGIT);
-    delay(digitDelay);
 }
 /**
  * @brief Zobrazí blikajicí hodiny pro mód nastavení času
@@ -154,12 +347,12 @@ void showMinutes(uint8_t minutes, uint16_t digitDelay) {
  */
 void showBlinkingHours(Time currentTime, Time settingsTime) {
     if (currentTime.seconds % 2 == 0) {
-        showHours(settingsTime.hours, DIGIT_DELAY);
+        showHours(settingsTime.hours);
     } else {
-        turnOffAllDigits();
-        delay(DIGIT_DELAY * 2);
+        clearDigit(HOURS_FIRST_DIGIT);
+        clearDigit(HOURS_SECOND_DIGIT);
     }
-    showMinutes(settingsTime.mins, DIGIT_DELAY);
+    showMinutes(settingsTime.mins);
 }
 
 /**
@@ -170,12 +363,12 @@ void showBlinkingHours(Time currentTime, Time settingsTime) {
  */
 
 void showBlinkingMinutes(Time currentTime, Time settingsTime) {
-    showHours(settingsTime.hours, DIGIT_DELAY);
+    showHours(settingsTime.hours);
     if (currentTime.seconds % 2 == 0) {
-        showMinutes(settingsTime.mins, DIGIT_DELAY);
+        showMinutes(settingsTime.mins);
     } else {
-        turnOffAllDigits();
-        delay(DIGIT_DELAY * 2);
+        clearDigit(MINUTES_FIRST_DIGIT);
+        clearDigit(MINUTES_SECOND_DIGIT);
     }
 }
 
@@ -186,14 +379,7 @@ void showBlinkingMinutes(Time currentTime, Time settingsTime) {
  */
 
 void showDash(int digit) {
-    turnOffAllDigits();
-    digitalWrite(RCLK, LOW);
-    shiftBit(0);  // point should be turned off
-    for (int i = NUMBER_OF_SEGMENTS - 1; i >= 0; i--) {
-        shiftBit(alarmTurnedOffSign[i]);
-    }
-    digitalWrite(RCLK, HIGH);
-    digitalWrite(digitsPins[digit], HIGH);
+    showChar('-', digit);
 }
 
 /**
@@ -204,33 +390,42 @@ void showDash(int digit) {
  */
 
 void showBlinkingDashes(Time currentTime, bool isHourPosition) {
-    if (isHourPosition) {
-        if (currentTime.seconds % 2 == 0) {
-            showDash(0);
-            delay(DIGIT_DELAY);
-            showDash(1);
-            delay(DIGIT_DELAY);
-        } else {
-            turnOffAllDigits();
-            delay(DIGIT_DELAY * 2);
+    for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
+        showDash(i);
+    }
+    if (currentTime.seconds % 2 != 0) {
+        uint8_t firstBlinkingDigit = isHourPosition ? HOURS_FIRST_DIGIT : MINUTES_FIRST_DIGIT;
+        clearDigit(firstBlinkingDigit);
+        clearDigit(firstBlinkingDigit + 1);
+    }
+}
+
+/**
+ * @brief Zobrazí nastavení délky odkladu buzení jako "Sn" a blikající počet minut
+ * 
+ * @param currentTime Aktuální čas nastavený na arduino
+ * @param minutes Délka odkladu v minutách
+ */
+void showBlinkingSnooze(Time currentTime, uint8_t minutes) {
+    showChar('S', HOURS_FIRST_DIGIT);
+    showChar('n', HOURS_SECOND_DIGIT);
+    if (currentTime.seconds % 2 == 0) {
+        showMinutes(minutes);
+        if (minutes < 10) {
+            clearDigit(MINUTES_FIRST_DIGIT);
         }
-        showDash(2);
-        delay(DIGIT_DELAY);
-        showDash(3);
-        delay(DIGIT_DELAY);
     } else {
-        showDash(0);
-        delay(DIGIT_DELAY);
-        showDash(1);
-        delay(DIGIT_DELAY);
-        if (currentTime.seconds % 2 == 0) {
-            showDash(2);
-            delay(DIGIT_DELAY);
-            showDash(3);
-            delay(DIGIT_DELAY);
-        } else {
-            turnOffAllDigits();
-            delay(DIGIT_DELAY * 2);
-        }
+        clearDigit(MINUTES_FIRST_DIGIT);
+        clearDigit(MINUTES_SECOND_DIGIT);
     }
 }
+
+/**
+ * @brief Rozsvítí nebo zhasne desetinnou tečku číslice, ostatní segmenty číslice zůstanou beze změny
+ * 
+ * @param digit Index číslice od 0 do 3
+ * @param lit True pokud má tečka svítit
+ */
+void setDigitDot(uint8_t digit, bool lit) {
+    frameBuffer[digit] = lit ? frameBuffer[digit] | SEGMENT_DOT : frameBuffer[digit] & ~SEGMENT_DOT;
+}
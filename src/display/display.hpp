@@ -4,27 +4,73 @@
 
 #include "time/time.hpp"
 
+/**
+ * Piny registru SN74HC595. S build flagem SPI_PIN_LAYOUT leží SER a SRCLK
+ * na pinech hardwarového SPI (MOSI a SCK) a segmenty posílá periferie SPI.
+ */
+#ifdef SPI_PIN_LAYOUT
+#define SER 11
+#define RCLK 3
+#define SRCLK 13
+#else
 #define SER 2
 #define RCLK 3
 #define SRCLK 4
+#endif
 #define NUMBER_OF_DIGITS 4
-#define NUMBER_OF_NUMBERS 10
 #define NUMBER_OF_SEGMENTS 7
 #define DOTS_PIN 8
-#define DIGIT_DELAY 1
+#define HOURS_FIRST_DIGIT_PIN 9
+#define HOURS_SECOND_DIGIT_PIN 10
+#define MINUTES_FIRST_DIGIT_PIN 5
+#define MINUTES_SECOND_DIGIT_PIN 6
+/**
+ * Počet obnovení celého displaye za sekundu, lze přepsat v build_flags
+ */
+#ifndef REFRESH_RATE
+#define REFRESH_RATE 125
+#endif
+/**
+ * Úrovně jasu. Každá číslice má slot stejné délky, na nižších úrovních se zhasne už během svého slotu.
+ * S build flagem NIGHT_DIMMING se v noci jas sníží na NIGHT_BRIGHTNESS.
+ */
+#define BRIGHTNESS_LEVELS 8
+#define MAX_BRIGHTNESS BRIGHTNESS_LEVELS
+#ifndef NIGHT_BRIGHTNESS
+#define NIGHT_BRIGHTNESS 2
+#endif
+#ifndef NIGHT_DIMMING_START_HOUR
+#define NIGHT_DIMMING_START_HOUR 22
+#endif
+#ifndef NIGHT_DIMMING_END_HOUR
+#define NIGHT_DIMMING_END_HOUR 6
+#endif
 
-extern uint8_t digitsPins[NUMBER_OF_DIGITS];
-extern uint8_t numbers[NUMBER_OF_NUMBERS][NUMBER_OF_SEGMENTS];
 
 void initDisplay();
+void refreshDisplay();
+void blankDisplay();
+void setBrightness(uint8_t level);
+uint8_t getBrightness();
+uint8_t brightnessForTime(Time time);
+void setDisplayEnabled(bool enabled);
 void showNumber(uint8_t number, uint8_t digit);
-void showTime(uint8_t hours, uint8_t minutes, uint16_t digitDelay);
+void showChar(char character, uint8_t digit);
+void showFlashText(const char* text);
+void setDigitSegments(uint8_t segments, uint8_t digit);
+void clearDigit(uint8_t digit);
+void showTime(uint8_t hours, uint8_t minutes);
+void showTimeDigits(TimeDigits digits);
+void showTemperature(int16_t quarterDegrees);
 void blinkWithDots(uint8_t seconds);
 void turnOffDots();
-void showMinutes(uint8_t minutes, uint16_t digitDelay);
-void showHours(uint8_t hours, uint16_t digitDelay);
+void showMinutes(uint8_t minutes);
+void showHours(uint8_t hours);
 void turnOffAllDigits();
+void turnOnDigit(uint8_t digit);
 void showBlinkingHours(Time currentTime, Time settingsTime);
 void showBlinkingMinutes(Time currentTime, Time settingsTime);
 void showBlinkingDashes(Time currentTime, bool isHourPosition);
+void showBlinkingSnooze(Time currentTime, uint8_t minutes);
+void setDigitDot(uint8_t digit, bool lit);
 #endif
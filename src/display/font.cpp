@@ -0,0 +1,130 @@
+#include "font.hpp"
+
+#include <Arduino.h>
+
+/**
+ * @brief Glyfy ASCII znaků od FONT_FIRST_CHAR do FONT_LAST_CHAR, jeden bajt na znak, uložené ve flash paměti
+ * Znaky, které na sedmisegmentovém displayi nejdou rozumně zobrazit, jsou prázdné.
+ * Velká písmena, která nemají vlastní tvar, se zobrazí jako malá (B -> b, D -> d, ...).
+ * Znak '*' slouží jako symbol stupně.
+ */
+const uint8_t font[FONT_LAST_CHAR - FONT_FIRST_CHAR + 1] PROGMEM = {
+    0x00,  // ' '
+    0x86,  // !
+    0x22,  // "
+    0x00,  // #
+    0x00,  // $
+    0x00,  // %
+    0x00,  // &
+    0x02,  // '
+    0x39,  // (
+    0x0F,  // )
+    0x63,  // * (stupeň)
+    0x00,  // +
+    0x10,  // ,
+    0x40,  // -
+    0x80,  // .
+    0x52,  // /
+    0x3F,  // 0
+    0x06,  // 1
+    0x5B,  // 2
+    0x4F,  // 3
+    0x66,  // 4
+    0x6D,  // 5
+    0x7D,  // 6
+    0x07,  // 7
+    0x7F,  // 8
+    0x6F,  // 9
+    0x00,  // :
+    0x00,  // ;
+    0x58,  // <
+    0x48,  // =
+    0x4C,  // >
+    0x53,  // ?
+    0x00,  // @
+    0x77,  // A
+    0x7C,  // B
+    0x39,  // C
+    0x5E,  // D
+    0x79,  // E
+    0x71,  // F
+    0x3D,  // G
+    0x76,  // H
+    0x30,  // I
+    0x1E,  // J
+    0x00,  // K
+    0x38,  // L
+    0x00,  // M
+    0x37,  // N
+    0x3F,  // O
+    0x73,  // P
+    0x67,  // Q
+    0x50,  // R
+    0x6D,  // S
+    0x78,  // T
+    0x3E,  // U
+    0x00,  // V
+    0x00,  // W
+    0x00,  // X
+    0x6E,  // Y
+    0x5B,  // Z
+    0x39,  // [
+    0x64,  // '\'
+    0x0F,  // ]
+    0x23,  // ^
+    0x08,  // _
+    0x20,  // `
+    0x77,  // a
+    0x7C,  // b
+    0x58,  // c
+    0x5E,  // d
+    0x79,  // e
+    0x71,  // f
+    0x3D,  // g
+    0x74,  // h
+    0x04,  // i
+    0x1E,  // j
+    0x00,  // k
+    0x38,  // l
+    0x00,  // m
+    0x54,  // n
+    0x5C,  // o
+    0x73,  // p
+    0x67,  // q
+    0x50,  // r
+    0x6D,  // s
+    0x78,  // t
+    0x1C,  // u
+    0x00,  // v
+    0x00,  // w
+    0x00,  // x
+    0x6E,  // y
+    0x5B,  // z
+    0x39,  // {
+    0x30,  // |
+    0x0F,  // }
+    0x01   // ~
+};
+
+/**
+ * @brief Vrátí bajt segmentů pro požadovaný znak
+ * 
+ * @param character ASCII znak
+ * @return Bajt segmentů, pro znaky mimo font 0 (zhasnutá číslice)
+ */
+uint8_t glyphSegments(char character) {
+    if (character < FONT_FIRST_CHAR || character > FONT_LAST_CHAR) {
+        return 0;
+    }
+    return pgm_read_byte(&font[character - FONT_FIRST_CHAR]);
+}
+
+/**
+ * @brief Vrátí bajt segmentů pro číslici od 0 do 9
+ * 
+ * @param number Číslice od 0 do 9
+ * @return Bajt segmentů
+ */
+uint8_t digitSegments(uint8_t number) {
+    return pgm_read_byte(&font['0' - FONT_FIRST_CHAR + number]);
+}
@@ -0,0 +1,23 @@
+#ifndef __FONT__HPP__
+#define __FONT__HPP__
+#include <Arduino.h>
+
+/**
+ * Bity segmentů v jednom bajtu glyfu, stejné pořadí jako ve frame bufferu displaye
+ */
+#define SEGMENT_A 0x01
+#define SEGMENT_B 0x02
+#define SEGMENT_C 0x04
+#define SEGMENT_D 0x08
+#define SEGMENT_E 0x10
+#define SEGMENT_F 0x20
+#define SEGMENT_G 0x40
+#define SEGMENT_DOT 0x80
+
+#define FONT_FIRST_CHAR ' '
+#define FONT_LAST_CHAR '~'
+
+uint8_t glyphSegments(char character);
+uint8_t digitSegments(uint8_t number);
+
+#endif
@@ -0,0 +1,99 @@
+#include "transport.hpp"
+
+#include <Arduino.h>
+
+#include "display/display.hpp"
+#include "gpio/gpio.hpp"
+#include "memory/memory.hpp"
+
+typedef GpioPin<SER> SerPin;
+typedef GpioPin<RCLK> RclkPin;
+typedef GpioPin<SRCLK> SrclkPin;
+
+#ifdef SPI_PIN_LAYOUT
+
+static_assert(SER == MOSI && SRCLK == SCK, "SPI_PIN_LAYOUT needs SER on MOSI and SRCLK on SCK");
+static_assert(HOURS_SECOND_DIGIT_PIN == SS, "SS has to stay an output, otherwise SPI drops out of master mode");
+
+/**
+ * @brief Číslice, která se rozsvítí po dokončení přenosu přes SPI
+ */
+volatile uint8_t pendingDigit;
+
+MEMORY_FOOTPRINT(transport, sizeof(pendingDigit));
+
+/**
+ * @brief Nastaví SPI jako master s hodinami F_CPU / 2 a přerušením po dokončení přenosu
+ * 
+ */
+void initDisplayTransport() {
+    RclkPin::setOutput();
+    SrclkPin::setOutput();
+    SerPin::setOutput();
+    SPSR = _BV(SPI2X);
+    SPCR = _BV(SPIE) | _BV(SPE) | _BV(MSTR);  // MSB první, mód 0
+}
+
+/**
+ * @brief Zhasne číslice a začne posílat bajt segmentů přes SPI, číslici rozsvítí až přerušení SPI
+ * 
+ * @param segments Bajt segmentů, bit 0 je segment A
+ * @param digit Index číslice od 0 do 3
+ */
+void sendSegments(uint8_t segments, uint8_t digit) {
+    turnOffAllDigits();
+    RclkPin::low();
+    pendingDigit = digit;
+    SPDR = segments;
+}
+
+/**
+ * @brief Přenos do registru SN74HC595 je hotový, stačí přepsat výstupy a rozsvítit číslici
+ * 
+ */
+ISR(SPI_STC_vect) {
+    RclkPin::high();
+    turnOnDigit(pendingDigit);
+}
+
+#else
+
+/**
+ * @brief Nastaví piny registru SN74HC595 jako výstupy
+ * 
+ */
+void initDisplayTransport() {
+    RclkPin::setOutput();
+    SrclkPin::setOutput();
+    SerPin::setOutput();
+}
+
+/**
+ * @brief Posune bit do registru SN74HC595, který udržuje informace o tom, co se má ukázat na displayi
+ * 
+ * @param value 
+ */
+inline void shiftBit(uint8_t value) {
+    SrclkPin::low();
+    SerPin::write(value);
+    SrclkPin::high();
+}
+
+/**
+ * @brief Zhasne číslice, pošle bajt segmentů do registru SN74HC595 a rozsvítí požadovanou číslici
+ * Jako první jde tečka (bit 7) a jako poslední segment A (bit 0)
+ * 
+ * @param segments Bajt segmentů, bit 0 je segment A
+ * @param digit Index číslice od 0 do 3
+ */
+void sendSegments(uint8_t segments, uint8_t digit) {
+    turnOffAllDigits();
+    RclkPin::low();
+    for (uint8_t mask = 0x80; mask != 0; mask >>= 1) {
+        shiftBit(segments & mask);
+    }
+    RclkPin::high();
+    turnOnDigit(digit);
+}
+
+#endif
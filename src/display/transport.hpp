@@ -0,0 +1,8 @@
+#ifndef __TRANSPORT__HPP__
+#define __TRANSPORT__HPP__
+#include <Arduino.h>
+
+void initDisplayTransport();
+void sendSegments(uint8_t segments, uint8_t digit);
+
+#endif
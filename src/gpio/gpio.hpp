@@ -0,0 +1,108 @@
+#ifndef __GPIO__HPP__
+#define __GPIO__HPP__
+#include <Arduino.h>
+
+#ifdef NATIVE
+/**
+ * @brief V nativním buildu simulátor sleduje každý zápis na výstupní piny, viz sim/panelSim.cpp
+ */
+void simPortWritten();
+#define GPIO_PORT_WRITTEN() simPortWritten()
+#else
+#define GPIO_PORT_WRITTEN()
+#endif
+
+/**
+ * @brief Stav vstupních registrů PINB, PINC a PIND přečtený v jednom okamžiku
+ *
+ */
+struct PortSnapshot {
+    uint8_t b;
+    uint8_t c;
+    uint8_t d;
+};
+
+/**
+ * @brief Přečte najednou všechny vstupní registry, aby se tlačítka vyhodnocovala ze stejného okamžiku
+ *
+ * @return Stav vstupních registrů
+ */
+inline PortSnapshot takePortSnapshot() {
+    PortSnapshot snapshot = {
+        .b = PINB,
+        .c = PINC,
+        .d = PIND};
+    return snapshot;
+}
+
+/**
+ * @brief Pin Arduina Nano (ATmega328), jehož registry a bitová maska jsou známé již při kompilaci
+ * D0-D7 leží na portu D, D8-D13 na portu B a A0-A5 na portu C.
+ * Zápis se přeloží na jedinou instrukci sbi/cbi, která je atomická a nemusí vypínat přerušení.
+ *
+ * @tparam PIN Číslo pinu stejně jako v digitalWrite
+ */
+template <uint8_t PIN>
+struct GpioPin {
+    static_assert(PIN < 20, "Pin does not exist on ATmega328");
+
+    static constexpr uint8_t bit = PIN < 8 ? PIN : (PIN < 14 ? PIN - 8 : PIN - 14);
+    static constexpr uint8_t mask = 1 << bit;
+    static constexpr uint8_t pinChangeGroup = PIN < 8 ? PCIE2 : (PIN < 14 ? PCIE0 : PCIE1);
+
+    static inline volatile uint8_t& port() {
+        return PIN < 8 ? PORTD : (PIN < 14 ? PORTB : PORTC);
+    }
+    static inline volatile uint8_t& ddr() {
+        return PIN < 8 ? DDRD : (PIN < 14 ? DDRB : DDRC);
+    }
+    static inline volatile uint8_t& input() {
+        return PIN < 8 ? PIND : (PIN < 14 ? PINB : PINC);
+    }
+    static inline volatile uint8_t& pinChangeMask() {
+        return PIN < 8 ? PCMSK2 : (PIN < 14 ? PCMSK0 : PCMSK1);
+    }
+
+    static inline void setOutput() {
+        ddr() |= mask;
+        GPIO_PORT_WRITTEN();
+    }
+    static inline void setInputPullup() {
+        ddr() &= ~mask;
+        port() |= mask;
+        GPIO_PORT_WRITTEN();
+    }
+    static inline void high() {
+        port() |= mask;
+        GPIO_PORT_WRITTEN();
+    }
+    static inline void low() {
+        port() &= ~mask;
+        GPIO_PORT_WRITTEN();
+    }
+    static inline void write(bool value) {
+        if (value) {
+            high();
+        } else {
+            low();
+        }
+    }
+    static inline bool read() {
+        return input() & mask;
+    }
+    /**
+     * @brief Povolí přerušení při změně úrovně pinu, obsluha je v gpio/pinChange.cpp
+     */
+    static inline void enablePinChangeInterrupt() {
+        pinChangeMask() |= mask;
+        PCICR |= _BV(pinChangeGroup);
+    }
+    /**
+     * @brief Přečte stav pinu z dříve pořízeného snímku vstupních registrů
+     */
+    static inline bool readFrom(const PortSnapshot& snapshot) {
+        return (PIN < 8 ? snapshot.d : (PIN < 14 ? snapshot.b : snapshot.c)) & mask;
+    }
+};
+
+#endif
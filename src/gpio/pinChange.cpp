@@ -0,0 +1,17 @@
+#include <Arduino.h>
+
+#include "buttons/buttonHandler.hpp"
+#include "time/rtc.hpp"
+
+/**
+ * @brief Společná obsluha přerušení při změně pinu pro všechny tři skupiny pinů
+ * Tlačítka leží na portech B, C i D (podle rozložení pinů), o tom, co se změnilo, rozhodne až debouncing.
+ * Pin INT čipu reálného času sdílí stejná přerušení, jeho sestupnou hranu si zapamatuje rtcPinChanged.
+ * 
+ */
+ISR(PCINT0_vect) {
+    buttonsPinChanged();
+    rtcPinChanged();
+}
+ISR(PCINT1_vect, ISR_ALIASOF(PCINT0_vect));
+ISR(PCINT2_vect, ISR_ALIASOF(PCINT0_vect));
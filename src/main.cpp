@@ -1,234 +1,200 @@
 #include <Arduino.h>
 
 #include "buttons/buttonHandler.hpp"
+#include "buttons/gestures.hpp"
 #include "display/display.hpp"
+#include "memory/memory.hpp"
+#include "power/power.hpp"
+#include "profiler/profiler.hpp"
+#include "protocol/protocol.hpp"
+#include "scheduler/scheduler.hpp"
+#include "settings/settings.hpp"
+#include "temperature/temperature.hpp"
+#include "tick/tick.hpp"
+#include "time/rtc.hpp"
 #include "time/time.hpp"
+#include "twi/twi.hpp"
+#include "ui/ui.hpp"
 
-#define MILLIS_IN_SECOND 1000
+/**
+ * Periody úloh plánovače v milisekundách
+ */
+#define TIME_SYNC_PERIOD_MILLIS 1000
+#define ALARM_PERIOD_MILLIS 60000
+#define DISPLAY_PERIOD_MILLIS 100
+#define BUTTONS_PERIOD_MILLIS 10
+#define SETTINGS_PERIOD_MILLIS 4
+#define SERIAL_PERIOD_MILLIS 10
+#define TELEMETRY_PERIOD_MILLIS 20
+#define MEMORY_WATCH_PERIOD_MILLIS 1000
 
-enum SetTimeSteps {
-    SET_HOURS,
-    SET_MINUTES
-};
 /**
- * @brief Jednotlivé stavy hodin
- * CLOCK_RUNNING - hodiny ukazují čas
- * TIME_SETTING - hodiny jsou v módu nastavování času
- * ALARM_SETTING - hodiny jsou v módu nastavování alarmu
+ * Počet úloh, které přidá setup, musí se vejít do tabulky plánovače, addTask při přeplnění úlohu zahodí
  */
-enum ClockStages {
-    CLOCK_RUNNING,
-    TIME_SETTING,
-    ALARM_SETTING
-};
+#define BASE_TASKS 6
+#ifdef PROFILER
+#define PROFILER_TASKS 1
+#else
+#define PROFILER_TASKS 0
+#endif
+#ifdef MEMORY_WATCH
+#define MEMORY_WATCH_TASKS 1
+#else
+#define MEMORY_WATCH_TASKS 0
+#endif
+
+static_assert(BASE_TASKS + PROFILER_TASKS + MEMORY_WATCH_TASKS <= MAX_TASKS,
+              "MAX_TASKS is too small for the enabled features");
+
 /**
  * @brief Datová struktura na udržování aktuálního času
  * 
  */
 Time currentTime;
-unsigned long lastMillis = 0;
-uint8_t setTimeStep = SET_HOURS;
 /**
- * @brief Aktuální mód hodin, ve kterém se hodiny nacházejí
+ * @brief Čas posledního stisku tlačítka, podle něj se v noci zhasíná display
  * 
  */
-uint8_t clockStage = CLOCK_RUNNING;
+unsigned long lastButtonMillis = 0;
+/**
+ * @brief Indexy úloh plánovače, které je potřeba spustit mimo jejich periodu
+ * 
+ */
+uint8_t timeSyncTask;
+uint8_t alarmTask;
+uint8_t displayTask;
 
-void clockRoutine();
+MEMORY_FOOTPRINT(main, sizeof(currentTime) + sizeof(lastButtonMillis) + sizeof(timeSyncTask) + sizeof(alarmTask) +
+                 sizeof(displayTask));
+
+void syncTime();
+void checkAlarm();
+void redrawDisplay();
 void handleButtons();
-void handleClockSetting(ButtonsStatus status);
-void setClockRoutine();
-void setAlarmRoutine();
-void handleAlarmSettings(ButtonsStatus status);
+void handleSerial();
+void sleepRoutine();
 
 /**
  * @brief První, ze dvou hlavních funkcí, zde dojde k inicializaci hodin
+ * Inicializace ničím nečeká, EEPROM se nemaže a čas v čipu reálného času se přepíše jen po ztrátě napájení
  */
 void setup() {
+    // display se rozsvítí jako první, aby hodiny hned po resetu něco ukazovaly
     initDisplay();
+    showFlashText(PSTR("----"));
+    initTick();
+    initButtons();
     initTime(13, 51, 0);
-    Serial.begin(9600);
+    initProtocol();
     currentTime = getTime();
-    initButtons();
+    showTime(currentTime.hours, currentTime.mins);
     initAlarmSettings();
+    initPower();
+    initProfiler();
+
+    // úlohy se stejným termínem běží v pořadí přidání, čas z čipu se tak načte dřív, než ho display zobrazí
+    timeSyncTask = addTask(syncTime, TIME_SYNC_PERIOD_MILLIS);
+    // alarm spouští přerušení od čipu reálného času, perioda je jen pojistka pro ztracenou hranu pinu INT
+    alarmTask = addTask(checkAlarm, ALARM_PERIOD_MILLIS);
+    addTask(handleButtons, BUTTONS_PERIOD_MILLIS);
+    displayTask = addTask(redrawDisplay, DISPLAY_PERIOD_MILLIS);
+    addTask(serviceSettings, SETTINGS_PERIOD_MILLIS);
+    addTask(handleSerial, SERIAL_PERIOD_MILLIS);
+#ifdef PROFILER
+    addTask(serviceProfiler, TELEMETRY_PERIOD_MILLIS);
+#endif
+#ifdef MEMORY_WATCH
+    addTask(serviceMemoryWatch, MEMORY_WATCH_PERIOD_MILLIS);
+#endif
 }
 /**
- * @brief Hlavní smyčka programu 
+ * @brief Hlavní smyčka programu, spustí úlohy, kterým nastal termín, a do dalšího termínu procesor uspí
  */
 
 void loop() {
-    switch (clockStage) {
-        case CLOCK_RUNNING:
-            clockRoutine();
-            break;
-        case TIME_SETTING:
-            setClockRoutine();
-            break;
-        case ALARM_SETTING:
-            setAlarmRoutine();
-            break;
+    if (takeRtcInterrupt()) {
+        runTaskNow(alarmTask);
+    }
+    // přenos času z čipu doběhl v přerušení TWI, vyzvedne se a zobrazí hned
+    if (takeTwiCompletion()) {
+        runTaskNow(timeSyncTask);
+        runTaskNow(displayTask);
     }
-    handleButtons();
+    runTasks();
+    sleepRoutine();
 }
+
 /**
- * @brief Funkce, která se stará o normální běh hodin
+ * @brief Úloha, která obslouží přenosy času, alarmu a teploty s čipem reálného času a načte aktuální čas
  */
-
-void clockRoutine() {
-    if (abs(millis() - lastMillis) >= MILLIS_IN_SECOND) {
-        currentTime = getTime();
-        lastMillis = millis();
-        blinkWithDots(currentTime.seconds);
-        checkAlarm(currentTime);
-    }
-    showTime(currentTime.hours, currentTime.mins, DIGIT_DELAY);
+void syncTime() {
+    serviceTime();
+    serviceAlarm();
+    serviceTemperature();
+    currentTime = getTime();
 }
 
 /**
- * @brief Funkce, která se stará o obsluhu tlačítek
- * 
+ * @brief Úloha, která začne číst příznaky alarmu z čipu reálného času, výsledek vyzvedne syncTime
  */
-void handleButtons() {
-    ButtonsStatus status = getButtonsStatus();
-    
-    if (status.setAlarmClicked || status.setTimeClicked || status.timeMinusClicked || status.timePlusClicked) {
-        if (isAlarmRinging()) {
-            turnOffAlarm();
-            return;
-        }
-    }
-
-    switch (clockStage) {
-        case CLOCK_RUNNING:
-            if (status.setTimeClicked) {
-                clockStage = TIME_SETTING;
-                prepareSettingsTime(false);
-            } else if (status.setAlarmClicked) {
-                prepareSettingsTime(true);
-                clockStage = ALARM_SETTING;
-            }
-            break;
-        case TIME_SETTING:
-            handleClockSetting(status);
-            break;
-        case ALARM_SETTING:
-            handleAlarmSettings(status);
-            break;
-    }
+void checkAlarm() {
+    requestAlarmCheck();
+    serviceAlarm();
 }
+
 /**
- * @brief Stará se o nastavení času na hodinách
- * @param status Stav všech tlačítek na desce
+ * @brief Úloha, která překreslí display podle stavu uživatelského rozhraní
  */
-
-void handleClockSetting(ButtonsStatus status) {
-    switch (setTimeStep) {
-        case SET_HOURS:
-            if (status.setTimeClicked) {
-                setTimeStep = SET_MINUTES;
-            } else if (status.timePlusClicked) {
-                incrementHour();
-            } else if (status.timeMinusClicked) {
-                decrementHour();
-            }
-            break;
-        case SET_MINUTES:
-            if (status.setTimeClicked) {
-                setTimeStep = SET_HOURS;
-                clockStage = CLOCK_RUNNING;
-                setTime(getSettingsTime());
-                currentTime = getTime();
-            } else if (status.timePlusClicked) {
-                incrementMinute();
-            } else if (status.timeMinusClicked) {
-                decrementMinute();
-            }
-            break;
-    }
+void redrawDisplay() {
+    redrawUi(currentTime);
 }
 
 /**
- * @brief Nastavení desky na mód nastavení času
+ * @brief Uspí procesor do dalšího přerušení, pokud žádná úloha nečeká, s build flagem NIGHT_DISPLAY_OFF v noci hodiny úplně uspí
  */
-
-void setClockRoutine() {
-    turnOffDots();
-    if (abs(millis() - lastMillis) >= MILLIS_IN_SECOND) {
-        currentTime = getTime();
-        lastMillis = millis();
-        checkAlarm(currentTime);
+void sleepRoutine() {
+#ifdef NIGHT_DISPLAY_OFF
+    bool nightSleep = getUiState() == UI_CLOCK && !isAlarmRinging() && isNightTime(currentTime) &&
+                      !isSettingsWritePending() && !isTwiBusy() &&
+                      millis() - lastButtonMillis >= DISPLAY_WAKE_MILLIS;
+    if (nightSleep) {
+        if (powerDown() == WAKE_BY_BUTTON) {
+            lastButtonMillis = millis();
+            setDisplayEnabled(true);
+        }
+        // millis() během spánku stojí, čas se musí načíst a zobrazit hned
+        runTaskNow(timeSyncTask);
+        runTaskNow(displayTask);
+        return;
     }
-    Time settingsTime = getSettingsTime();
-    switch (setTimeStep) {
-        case SET_HOURS:
-            showBlinkingHours(currentTime, settingsTime);
-            break;
-        case SET_MINUTES:
-            showBlinkingMinutes(currentTime, settingsTime);
-            break;
+    setDisplayEnabled(true);
+#endif
+    if (millisUntilNextTask() > 0) {
+        idle();
     }
 }
-
 /**
- * @brief Funkce na nastavení alarmu
- * @param status Stav tlačítek na desce
+ * @brief Úloha, která předá gesta tlačítek stavovému automatu uživatelského rozhraní
+ * Perioda úlohy zároveň určuje přesnost měření dlouhého stisku a opakování.
+ * 
  */
-
-void handleAlarmSettings(ButtonsStatus status) {
-    switch (setTimeStep) {
-        case SET_HOURS:
-            if (status.setAlarmClicked) {
-                setTimeStep = SET_MINUTES;
-            } else if (status.timePlusClicked) {
-                incrementHour();
-            } else if (status.timeMinusClicked) {
-                decrementHour();
-            } else if (status.setTimeClicked) {
-                toggleAlarmStatus();
-            }
-            break;
-        case SET_MINUTES:
-            if (status.setAlarmClicked) {
-                setTimeStep = SET_HOURS;
-                clockStage = CLOCK_RUNNING;
-                setAlarmTime(getSettingsTime());
-                currentTime = getTime();
-            } else if (status.timePlusClicked) {
-                incrementMinute();
-            } else if (status.timeMinusClicked) {
-                decrementMinute();
-            } else if (status.setTimeClicked) {
-                toggleAlarmStatus();
-            }
-            break;
+void handleButtons() {
+    PROFILE_SCOPE(PROFILE_HANDLE_BUTTONS);
+    uint8_t gesture;
+    while (popGesture(&gesture)) {
+        lastButtonMillis = millis();
+        handleUiEvent(gesture);
+        runTaskNow(displayTask);
     }
 }
+
 /**
- * @brief Nastaví stav hodin na mód nastavení alarmu
+ * @brief Úloha, která zpracuje příkazy ze sériové linky, po změně času se čas hned načte a zobrazí
+ * 
  */
-
-void setAlarmRoutine() {
-    turnOffDots();
-    if (abs(millis() - lastMillis) >= MILLIS_IN_SECOND) {
-        currentTime = getTime();
-        lastMillis = millis();
-        checkAlarm(currentTime);
-    }
-    Time settingsTime = getSettingsTime();
-    switch (setTimeStep) {
-        case SET_HOURS:
-            if (getAlarmSettings().on) {
-                showBlinkingHours(currentTime, settingsTime);
-            } else {
-                showBlinkingDashes(currentTime, true);
-            }
-            break;
-        case SET_MINUTES:
-            if (getAlarmSettings().on) {
-                showBlinkingMinutes(currentTime, settingsTime);
-            } else {
-                showBlinkingDashes(currentTime, false);
-            }
-            break;
+void handleSerial() {
+    if (serviceProtocol()) {
+        runTaskNow(timeSyncTask);
+        runTaskNow(displayTask);
     }
 }
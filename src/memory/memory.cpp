@@ -0,0 +1,231 @@
+#include "memory.hpp"
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+/**
+ * @brief Statická data jednotlivých modulů, definovaná makrem MEMORY_FOOTPRINT v jejich souborech
+ */
+extern const uint16_t mainFootprint;
+extern const uint16_t displayFootprint;
+extern const uint16_t tickFootprint;
+extern const uint16_t buttonsFootprint;
+extern const uint16_t eventsFootprint;
+extern const uint16_t gesturesFootprint;
+extern const uint16_t timeFootprint;
+extern const uint16_t rtcFootprint;
+extern const uint16_t twiFootprint;
+extern const uint16_t temperatureFootprint;
+extern const uint16_t buzzerFootprint;
+extern const uint16_t settingsFootprint;
+extern const uint16_t schedulerFootprint;
+extern const uint16_t uiFootprint;
+extern const uint16_t protocolFootprint;
+extern const uint16_t traceFootprint;
+#ifdef SPI_PIN_LAYOUT
+extern const uint16_t transportFootprint;
+#endif
+extern const uint16_t memoryFootprint;
+#ifdef PROFILER
+extern const uint16_t profilerFootprint;
+#endif
+
+const char mainFootprintName[] PROGMEM = "main";
+const char displayFootprintName[] PROGMEM = "display";
+const char tickFootprintName[] PROGMEM = "tick";
+const char buttonsFootprintName[] PROGMEM = "buttons";
+const char eventsFootprintName[] PROGMEM = "events";
+const char gesturesFootprintName[] PROGMEM = "gestures";
+const char timeFootprintName[] PROGMEM = "time";
+const char rtcFootprintName[] PROGMEM = "rtc";
+const char twiFootprintName[] PROGMEM = "twi";
+const char temperatureFootprintName[] PROGMEM = "temp";
+const char buzzerFootprintName[] PROGMEM = "buzzer";
+const char settingsFootprintName[] PROGMEM = "settings";
+const char schedulerFootprintName[] PROGMEM = "scheduler";
+const char uiFootprintName[] PROGMEM = "ui";
+const char protocolFootprintName[] PROGMEM = "protocol";
+const char traceFootprintName[] PROGMEM = "trace";
+#ifdef SPI_PIN_LAYOUT
+const char transportFootprintName[] PROGMEM = "transport";
+#endif
+const char memoryFootprintName[] PROGMEM = "memory";
+#ifdef PROFILER
+const char profilerFootprintName[] PROGMEM = "profiler";
+#endif
+/**
+ * @brief Zbytek statických dat, který nepatří žádnému modulu: buffery Serial a proměnné jádra Arduina
+ */
+const char otherFootprintName[] PROGMEM = "other";
+
+struct Footprint {
+    const char* name;
+    const uint16_t* bytes;
+};
+
+#define FOOTPRINT(module) {module##FootprintName, &module##Footprint}
+
+const Footprint footprints[] PROGMEM = {
+    FOOTPRINT(main),
+    FOOTPRINT(display),
+    FOOTPRINT(tick),
+    FOOTPRINT(buttons),
+    FOOTPRINT(events),
+    FOOTPRINT(gestures),
+    FOOTPRINT(time),
+    FOOTPRINT(rtc),
+    FOOTPRINT(twi),
+    FOOTPRINT(temperature),
+    FOOTPRINT(buzzer),
+    FOOTPRINT(settings),
+    FOOTPRINT(scheduler),
+    FOOTPRINT(ui),
+    FOOTPRINT(protocol),
+    FOOTPRINT(trace),
+#ifdef SPI_PIN_LAYOUT
+    FOOTPRINT(transport),
+#endif
+    FOOTPRINT(memory),
+#ifdef PROFILER
+    FOOTPRINT(profiler),
+#endif
+};
+
+#define NUMBER_OF_MODULES (sizeof(footprints) / sizeof(footprints[0]))
+
+/**
+ * @brief Zdali rezerva zásobníku někdy klesla pod MEMORY_HEADROOM_THRESHOLD, příznak už se nesmaže
+ */
+bool memoryLow = false;
+
+MEMORY_FOOTPRINT(memory, sizeof(memoryLow));
+
+#ifndef NATIVE
+/**
+ * @brief Symboly linkeru: začátek statických dat a konec statických dat, kde by začínala halda
+ */
+extern uint8_t __data_start;
+extern uint8_t __heap_start;
+
+#define STRINGIFY(value) #value
+#define EXPAND_AND_STRINGIFY(value) STRINGIFY(value)
+#define STACK_CANARY_TEXT EXPAND_AND_STRINGIFY(STACK_CANARY)
+
+/**
+ * @brief Hned po resetu, ještě před nastavením zásobníku a inicializací proměnných, vyplní paměť od konce
+ * statických dat po vrchol zásobníku hodnotou STACK_CANARY
+ * Běží v sekci .init1, kde ještě neplatí r1 = 0 ani ukazatel zásobníku, proto je napsaná v assembleru
+ * a nesmí mít operandy, které by v naked funkci potřebovaly registry.
+ */
+void paintStack() __attribute__((naked, used, section(".init1")));
+void paintStack() {
+    __asm__ volatile(
+        "    ldi r30, lo8(__heap_start)\n"
+        "    ldi r31, hi8(__heap_start)\n"
+        "    ldi r24, " STACK_CANARY_TEXT "\n"
+        "    ldi r25, hi8(__stack)\n"
+        "    rjmp 2f\n"
+        "1:  st Z+, r24\n"
+        "2:  cpi r30, lo8(__stack)\n"
+        "    cpc r31, r25\n"
+        "    brlo 1b\n"
+        "    breq 1b\n");
+}
+
+/**
+ * @brief Spočítá bajty nad statickými daty, které zásobník od resetu nikdy nepřepsal
+ */
+uint16_t measureStackHeadroom() {
+    const uint8_t* address = &__heap_start;
+    const uint8_t* stackPointer = (const uint8_t*)SP;
+    uint16_t headroom = 0;
+    while (address < stackPointer && *address == STACK_CANARY) {
+        address++;
+        headroom++;
+    }
+    return headroom;
+}
+#endif
+
+/**
+ * @brief Sečte statická data všech modulů z tabulky footprints
+ */
+uint16_t sumModuleFootprints() {
+    uint16_t bytes = 0;
+    for (uint8_t i = 0; i < NUMBER_OF_MODULES; i++) {
+        bytes += pgm_read_word(pgm_read_ptr(&footprints[i].bytes));
+    }
+    return bytes;
+}
+
+/**
+ * @brief Změří využití SRAM
+ * V nativním buildu simulátoru paměť AVR neexistuje, statická data jsou jen součtem modulů a ostatní hodnoty jsou 0.
+ * 
+ * @return Statická data, volná paměť mezi daty a aktuálním vrcholem zásobníku a nejmenší rezerva zásobníku od startu
+ */
+MemoryStats getMemoryStats() {
+    MemoryStats stats = {0, 0, 0};
+#ifdef NATIVE
+    stats.staticBytes = sumModuleFootprints();
+#else
+    stats.staticBytes = &__heap_start - &__data_start;
+    stats.freeBytes = (const uint8_t*)SP - &__heap_start;
+    stats.stackHeadroom = measureStackHeadroom();
+#endif
+    return stats;
+}
+
+/**
+ * @brief Úloha pro build flag MEMORY_WATCH, zkontroluje rezervu zásobníku a případně nastaví příznak nedostatku paměti
+ * 
+ */
+void serviceMemoryWatch() {
+#ifndef NATIVE
+    if (measureStackHeadroom() < MEMORY_HEADROOM_THRESHOLD) {
+        memoryLow = true;
+    }
+#endif
+}
+
+/**
+ * @brief Zjistí, zdali úloha serviceMemoryWatch někdy naměřila rezervu zásobníku pod MEMORY_HEADROOM_THRESHOLD
+ */
+bool isMemoryLow() {
+    return memoryLow;
+}
+
+/**
+ * @brief Počet položek rozpisu statických dat včetně posledního zbytku "other"
+ */
+uint8_t getNumberOfFootprints() {
+    return NUMBER_OF_MODULES + 1;
+}
+
+/**
+ * @brief Vrátí jednu položku rozpisu statických dat
+ * 
+ * @param index Index položky, menší než getNumberOfFootprints()
+ * @param name Kam se zkopíruje název, nejvýše MEMORY_FOOTPRINT_NAME_LENGTH znaků a ukončovací nula
+ * @return Velikost statických dat v bajtech
+ */
+uint16_t getFootprint(uint8_t index, char* name) {
+    const char* source = otherFootprintName;
+    uint16_t bytes = 0;
+    if (index < NUMBER_OF_MODULES) {
+        source = (const char*)pgm_read_ptr(&footprints[index].name);
+        bytes = pgm_read_word(pgm_read_ptr(&footprints[index].bytes));
+    } else {
+        // zbytek statických dat je všechno, co nepatří žádnému modulu
+        uint16_t modules = sumModuleFootprints();
+        uint16_t total = getMemoryStats().staticBytes;
+        bytes = total > modules ? total - modules : 0;
+    }
+    uint8_t length = 0;
+    char character;
+    while (length < MEMORY_FOOTPRINT_NAME_LENGTH && (character = pgm_read_byte(source + length)) != '\0') {
+        name[length++] = character;
+    }
+    name[length] = '\0';
+    return bytes;
+}
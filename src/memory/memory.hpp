@@ -0,0 +1,39 @@
+#ifndef __MEMORY__HPP__
+#define __MEMORY__HPP__
+#include <Arduino.h>
+
+/**
+ * Měření paměti SRAM: statická data, volná paměť mezi daty a zásobníkem a nejmenší rezerva zásobníku od startu.
+ * Paměť mezi statickými daty a zásobníkem se hned po resetu vyplní hodnotou STACK_CANARY,
+ * rezerva je počet bajtů, které zásobník ještě nikdy nepřepsal. Program nepoužívá malloc, halda je prázdná.
+ * 
+ * S build flagem MEMORY_WATCH se rezerva kontroluje každou sekundu a při poklesu pod MEMORY_HEADROOM_THRESHOLD
+ * bajtů se natrvalo rozsvítí tečka za první číslicí.
+ */
+#define STACK_CANARY 0xC5
+#ifndef MEMORY_HEADROOM_THRESHOLD
+#define MEMORY_HEADROOM_THRESHOLD 128
+#endif
+#define MEMORY_FOOTPRINT_NAME_LENGTH 10
+
+/**
+ * Statická data modulu v SRAM, uvádí se v souboru modulu hned za jeho globálními proměnnými
+ * a modul se přidá do tabulky footprints v memory.cpp
+ */
+#define MEMORY_FOOTPRINT(module, bytes)              \
+    extern const uint16_t module##Footprint PROGMEM; \
+    const uint16_t module##Footprint PROGMEM = (bytes)
+
+struct MemoryStats {
+    uint16_t staticBytes;
+    uint16_t freeBytes;
+    uint16_t stackHeadroom;
+};
+
+MemoryStats getMemoryStats();
+void serviceMemoryWatch();
+bool isMemoryLow();
+uint8_t getNumberOfFootprints();
+uint16_t getFootprint(uint8_t index, char* name);
+
+#endif
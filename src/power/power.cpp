@@ -0,0 +1,73 @@
+#include "power.hpp"
+
+#include <Arduino.h>
+#include <avr/power.h>
+#include <avr/sleep.h>
+
+#include "display/display.hpp"
+#include "tick/tick.hpp"
+#include "time/rtc.hpp"
+
+/**
+ * @brief Vypne periferie, které hodiny nepoužívají
+ * 
+ */
+void initPower() {
+    ADCSRA = 0;
+    power_adc_disable();
+    ACSR = _BV(ACD);  // analogový komparátor
+}
+
+/**
+ * @brief Uspí procesor v režimu idle do nejbližšího přerušení
+ * Časovače běží dál, takže procesor probudí nejpozději další tick displaye nebo přerušení millis().
+ * 
+ */
+void idle() {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sleep_cpu();
+    sleep_disable();
+}
+
+/**
+ * @brief Zjistí, zdali je čas v rozmezí nočního vypnutí displaye
+ * 
+ * @param time Aktuální čas
+ * @return true Pokud je noc
+ */
+bool isNightTime(Time time) {
+    return isTimeBetweenHours(time, NIGHT_DISPLAY_OFF_START_HOUR, NIGHT_DISPLAY_OFF_END_HOUR);
+}
+
+/**
+ * @brief Zhasne display a uspí procesor v režimu power-down
+ * Z něj ho probudí jen přerušení při změně pinu, tedy stisk tlačítka nebo pin INT čipu DS3231,
+ * který je po dobu spánku nastaven na přerušení na začátku každé minuty.
+ * 
+ * @return Zdroj probuzení (WakeSources)
+ */
+uint8_t powerDown() {
+    stopTick();
+    setDisplayEnabled(false);
+    setRtcMinuteInterrupt(true);
+
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    noInterrupts();
+    // pin INT, který už je v 0, by procesor neprobudil, čip mohl alarm ohlásit ještě před usnutím
+    if (!isRtcInterruptActive()) {
+        sleep_enable();
+        sleep_bod_disable();
+        interrupts();
+        sleep_cpu();
+        sleep_disable();
+    }
+    interrupts();
+
+    uint8_t wakeSource = isRtcInterruptActive() ? WAKE_BY_RTC : WAKE_BY_BUTTON;
+    setRtcMinuteInterrupt(false);
+    initTick();
+    // tick během spánku stál, čas se musí znovu přečíst z čipu
+    requestTimeResync();
+    return wakeSource;
+}
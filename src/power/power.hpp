@@ -0,0 +1,32 @@
+#ifndef __POWER__HPP__
+#define __POWER__HPP__
+#include <Arduino.h>
+
+#include "time/time.hpp"
+
+/**
+ * Noční vypnutí displaye se zapíná build flagem NIGHT_DISPLAY_OFF.
+ * V noci se hodiny uspí do režimu power-down, probudí je stisk tlačítka nebo každá celá minuta z čipu DS3231.
+ */
+#ifndef NIGHT_DISPLAY_OFF_START_HOUR
+#define NIGHT_DISPLAY_OFF_START_HOUR 23
+#endif
+#ifndef NIGHT_DISPLAY_OFF_END_HOUR
+#define NIGHT_DISPLAY_OFF_END_HOUR 6
+#endif
+/**
+ * Jak dlouho display po stisku tlačítka v noci svítí
+ */
+#define DISPLAY_WAKE_MILLIS 10000
+
+enum WakeSources {
+    WAKE_BY_BUTTON,
+    WAKE_BY_RTC
+};
+
+void initPower();
+void idle();
+bool isNightTime(Time time);
+uint8_t powerDown();
+
+#endif
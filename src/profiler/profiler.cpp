@@ -0,0 +1,245 @@
+#include "profiler.hpp"
+
+#ifdef PROFILER
+#include <util/atomic.h>
+
+#include "scheduler/scheduler.hpp"
+#include "memory/memory.hpp"
+#include "tick/tick.hpp"
+
+/**
+ * Perioda ticku v krocích časovače 1, tick, který přijde o půl periody později, znamená vynechanou obnovu displaye
+ */
+#define TICK_PERIOD_TICKS ((uint16_t)(PROFILER_TICKS_PER_MICROS * 1000000UL / TICK_FREQUENCY))
+
+/**
+ * Nejdelší řádek souhrnu včetně konce řádku, musí se vejít do vysílacího bufferu sériové linky (63 bajtů)
+ */
+#define REPORT_LINE_LENGTH 60
+
+static_assert(PROFILER_TICKS_PER_MICROS * 1000000UL / TICK_FREQUENCY < 32768,
+              "Tick period does not fit profiler timer");
+
+/**
+ * @brief Krátké názvy úseků pro souhrn na sériové lince
+ */
+const char uiRedrawName[] PROGMEM = "redraw";
+const char handleButtonsName[] PROGMEM = "button";
+const char rtcReadName[] PROGMEM = "rtc";
+const char tickName[] PROGMEM = "tick";
+const char* const sectionNames[NUMBER_OF_PROFILE_SECTIONS] PROGMEM = {
+    uiRedrawName, handleButtonsName, rtcReadName, tickName};
+
+/**
+ * @brief Statistiky úseků, úsek PROFILE_TICK zapisuje přerušení ticku, ostatní hlavní smyčka
+ */
+volatile ProfileStats profileStats[NUMBER_OF_PROFILE_SECTIONS];
+
+/**
+ * @brief Čas posledního ticku, počet vynechaných obnov displaye a největší zpoždění ticku od začátku měření
+ */
+volatile uint16_t lastTickTimer;
+volatile bool lastTickValid = false;
+volatile uint16_t missedFrames = 0;
+volatile uint16_t maxTickLateness = 0;
+
+unsigned long lastReportMillis = 0;
+/**
+ * @brief Který řádek souhrnu se pošle jako další
+ * Po řádcích úseků následuje řádek s obnovou displaye a za ním řádky úloh plánovače.
+ */
+#define DISPLAY_REPORT_LINE NUMBER_OF_PROFILE_SECTIONS
+#define FIRST_TASK_REPORT_LINE (NUMBER_OF_PROFILE_SECTIONS + 1)
+uint8_t reportLine = UINT8_MAX;
+
+MEMORY_FOOTPRINT(profiler, sizeof(profileStats) + sizeof(lastTickTimer) + sizeof(lastTickValid) + sizeof(missedFrames) +
+                 sizeof(maxTickLateness) + sizeof(lastReportMillis) + sizeof(reportLine));
+
+/**
+ * @brief Vynuluje statistiku úseku
+ */
+void resetStats(volatile ProfileStats* stats) {
+    stats->count = 0;
+    stats->min = UINT16_MAX;
+    stats->max = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        stats->histogram[i] = 0;
+    }
+}
+
+/**
+ * @brief Spustí časovač 1 jako volně běžící čítač, časovač tím přestane sloužit pro PWM na pinech 9 a 10
+ * 
+ */
+void initProfiler() {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        TCCR1A = 0;
+        TCCR1B = _BV(CS11);  // normální režim, předdělička 8
+        TIMSK1 = 0;
+        for (uint8_t i = 0; i < NUMBER_OF_PROFILE_SECTIONS; i++) {
+            resetStats(&profileStats[i]);
+        }
+    }
+    lastReportMillis = millis();
+}
+
+/**
+ * @brief Přečte čítač časovače 1
+ * 16bitový registr se čte přes sdílený pomocný registr, přerušení ho nesmí mezi čtením bajtů přepsat.
+ * 
+ * @return Aktuální hodnota čítače
+ */
+uint16_t profilerTimer() {
+    uint16_t timer;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        timer = TCNT1;
+    }
+    return timer;
+}
+
+/**
+ * @brief Započítá jedno změření úseku do jeho statistiky
+ * 
+ * @param section Úsek z ProfileSections
+ * @param ticks Délka v krocích časovače 1
+ */
+void recordProfile(uint8_t section, uint16_t ticks) {
+    uint16_t micros = ticks / PROFILER_TICKS_PER_MICROS;
+    uint8_t bucket = 0;
+    for (uint16_t limit = PROFILER_HISTOGRAM_FIRST_MICROS; micros >= limit && bucket < PROFILER_HISTOGRAM_BUCKETS - 1;
+         limit <<= 1) {
+        bucket++;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        volatile ProfileStats* stats = &profileStats[section];
+        if (stats->count < UINT16_MAX) {
+            stats->count++;
+        }
+        if (ticks < stats->min) {
+            stats->min = ticks;
+        }
+        if (ticks > stats->max) {
+            stats->max = ticks;
+        }
+        if (stats->histogram[bucket] < UINT16_MAX) {
+            stats->histogram[bucket]++;
+        }
+    }
+}
+
+/**
+ * @brief Tick se znovu spustil (po power-down), mezera od posledního ticku se nepočítá jako vynechané obnovy
+ * 
+ */
+void profileTickStarted() {
+    lastTickValid = false;
+}
+
+/**
+ * @brief Volá se na začátku přerušení ticku, z mezery mezi ticky pozná zpoždění a vynechané obnovy displaye
+ * Zpoždění vzniká, když hlavní smyčka nebo jiné přerušení drží přerušení zakázaná.
+ * 
+ */
+void profileTickEntered() {
+    uint16_t now = TCNT1;
+    if (lastTickValid) {
+        uint16_t interval = now - lastTickTimer;
+        if (interval > TICK_PERIOD_TICKS) {
+            uint16_t lateness = interval - TICK_PERIOD_TICKS;
+            if (lateness > maxTickLateness) {
+                maxTickLateness = lateness;
+            }
+            missedFrames += (lateness + TICK_PERIOD_TICKS / 2) / TICK_PERIOD_TICKS;
+        }
+    }
+    lastTickTimer = now;
+    lastTickValid = true;
+}
+
+/**
+ * @brief Pošle na sériovou linku jeden řádek souhrnu, jen pokud se celý vejde do vysílacího bufferu
+ * Řádek úseku: "P název počet min max h0 h1 ... h7", časy jsou v us a sloupce histogramu v procentech počtu.
+ * Řádek displaye: "F vynechané_obnovy největší_zpoždění_us".
+ * Řádek úlohy plánovače: "T index největší_zpoždění_ms zmeškané_termíny".
+ * 
+ * @param line Index řádku
+ * @return true Pokud se řádek poslal
+ */
+bool sendReportLine(uint8_t line) {
+    if (Serial.availableForWrite() < REPORT_LINE_LENGTH) {
+        return false;
+    }
+    if (line >= FIRST_TASK_REPORT_LINE) {
+        uint8_t task = line - FIRST_TASK_REPORT_LINE;
+        Task stats = takeTaskStats(task);
+        Serial.print(F("T "));
+        Serial.print(task);
+        Serial.print(' ');
+        Serial.print(stats.maxLatenessMillis);
+        Serial.print(' ');
+        Serial.println(stats.missedDeadlines);
+        return true;
+    }
+    if (line == DISPLAY_REPORT_LINE) {
+        uint16_t missed;
+        uint16_t lateness;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            missed = missedFrames;
+            lateness = maxTickLateness;
+            missedFrames = 0;
+            maxTickLateness = 0;
+        }
+        Serial.print(F("F "));
+        Serial.print(missed);
+        Serial.print(' ');
+        Serial.println(lateness / PROFILER_TICKS_PER_MICROS);
+        return true;
+    }
+    ProfileStats stats;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        stats.count = profileStats[line].count;
+        stats.min = profileStats[line].min;
+        stats.max = profileStats[line].max;
+        for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+            stats.histogram[i] = profileStats[line].histogram[i];
+        }
+        resetStats(&profileStats[line]);
+    }
+    if (stats.count == 0) {
+        return true;
+    }
+    Serial.print(F("P "));
+    Serial.print(reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&sectionNames[line])));
+    Serial.print(' ');
+    Serial.print(stats.count);
+    Serial.print(' ');
+    Serial.print(stats.min / PROFILER_TICKS_PER_MICROS);
+    Serial.print(' ');
+    Serial.print(stats.max / PROFILER_TICKS_PER_MICROS);
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        Serial.print(' ');
+        Serial.print((uint8_t)((uint32_t)stats.histogram[i] * 100 / stats.count));
+    }
+    Serial.println();
+    return true;
+}
+
+/**
+ * @brief Úloha plánovače, každých PROFILER_REPORT_MILLIS pošle souhrn a vynuluje statistiky
+ * Souhrn se posílá po řádcích, aby se hlavní smyčka nikdy nezastavila čekáním na pomalou sériovou linku.
+ * 
+ */
+void serviceProfiler() {
+    if (reportLine >= FIRST_TASK_REPORT_LINE + getNumberOfTasks()) {
+        if (millis() - lastReportMillis < PROFILER_REPORT_MILLIS) {
+            return;
+        }
+        lastReportMillis = millis();
+        reportLine = 0;
+    }
+    if (sendReportLine(reportLine)) {
+        reportLine++;
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __PROFILER__HPP__
+#define __PROFILER__HPP__
+#include <Arduino.h>
+
+/**
+ * Měření doby běhu částí programu, zapíná se build flagem PROFILER.
+ * Bez něj se makra i funkce přeloží na nic a program je stejný jako bez profileru.
+ *
+ * Délku měří volně běžící časovač 1 s předděličkou 8, tedy 2 kroky za mikrosekundu při 16 MHz.
+ * Jeden úsek tak může trvat nejvýše 32 ms, delší úsek se změří s přetečením.
+ */
+#define PROFILER_TIMER_PRESCALER 8
+#define PROFILER_TICKS_PER_MICROS (F_CPU / PROFILER_TIMER_PRESCALER / 1000000UL)
+/**
+ * Jak často se posílá souhrn na sériovou linku a počet sloupců histogramu doby běhu
+ * Sloupec 0 jsou úseky kratší než 4 us, každý další sloupec má dvojnásobnou šířku, poslední je 256 us a více.
+ */
+#define PROFILER_REPORT_MILLIS 10000
+#define PROFILER_HISTOGRAM_BUCKETS 8
+#define PROFILER_HISTOGRAM_FIRST_MICROS 4
+
+/**
+ * Měřené úseky programu
+ */
+enum ProfileSections {
+    PROFILE_UI_REDRAW,
+    PROFILE_HANDLE_BUTTONS,
+    PROFILE_RTC_READ,
+    PROFILE_TICK,
+    NUMBER_OF_PROFILE_SECTIONS
+};
+
+#ifdef PROFILER
+
+/**
+ * Statistika jednoho úseku od posledního souhrnu, časy jsou v krocích časovače 1
+ */
+struct ProfileStats {
+    uint16_t count;
+    uint16_t min;
+    uint16_t max;
+    uint16_t histogram[PROFILER_HISTOGRAM_BUCKETS];
+};
+
+void initProfiler();
+void serviceProfiler();
+void profileTickStarted();
+void profileTickEntered();
+void recordProfile(uint8_t section, uint16_t ticks);
+uint16_t profilerTimer();
+
+/**
+ * Změří dobu od svého vytvoření do konce bloku, ve kterém je vytvořen
+ */
+struct ProfileScope {
+    uint8_t section;
+    uint16_t start;
+
+    ProfileScope(uint8_t section) : section(section), start(profilerTimer()) {}
+    ~ProfileScope() {
+        recordProfile(section, profilerTimer() - start);
+    }
+};
+
+#define PROFILE_SCOPE(section) ProfileScope profileScope(section)
+
+#else
+
+#define PROFILE_SCOPE(section)
+inline void initProfiler() {}
+inline void serviceProfiler() {}
+inline void profileTickStarted() {}
+inline void profileTickEntered() {}
+
+#endif
+
+#endif
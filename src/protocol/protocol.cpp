@@ -0,0 +1,334 @@
+#include "protocol.hpp"
+
+#include <Arduino.h>
+
+#include "crc/crc.hpp"
+#include "display/display.hpp"
+#include "memory/memory.hpp"
+#include "time/time.hpp"
+#include "trace/trace.hpp"
+#include "ui/ui.hpp"
+
+#define PROTOCOL_FRAME_SIZE (PROTOCOL_MAX_PAYLOAD + PROTOCOL_FRAME_OVERHEAD)
+
+static_assert(3 + MEMORY_FOOTPRINT_NAME_LENGTH + 1 <= PROTOCOL_MAX_PAYLOAD,
+              "PROTOCOL_GET_FOOTPRINT response does not fit into PROTOCOL_MAX_PAYLOAD");
+static_assert(TRACE_LENGTH <= 255, "TRACE_LENGTH does not fit into PROTOCOL_GET_TRACE response");
+
+/**
+ * @brief Pozice bajtů v rámci, data začínají hned za příkazem a CRC je za nimi
+ */
+enum FramePosition {
+    FRAME_START,
+    FRAME_LENGTH,
+    FRAME_COMMAND,
+    FRAME_PAYLOAD
+};
+
+enum ParserState {
+    WAIT_START,
+    WAIT_LENGTH,
+    WAIT_COMMAND,
+    WAIT_PAYLOAD,
+    WAIT_CRC
+};
+
+/**
+ * @brief Rámec, do kterého se skládají přijaté bajty, odpověď se pak sestaví na stejném místě
+ * Přijaté bajty čekají v kruhovém bufferu HardwareSerial, který plní přerušení přijímače,
+ * takže úloha může bajty vybírat až ve svém termínu.
+ */
+uint8_t frame[PROTOCOL_FRAME_SIZE];
+uint8_t frameIndex = 0;
+uint8_t parserState = WAIT_START;
+unsigned long lastByteMillis = 0;
+/**
+ * @brief Počet zahozených rámců (špatná délka, CRC nebo vypršení času mezi bajty)
+ */
+uint16_t badFrames = 0;
+
+MEMORY_FOOTPRINT(protocol, sizeof(frame) + sizeof(frameIndex) + sizeof(parserState) + sizeof(lastByteMillis) +
+                 sizeof(badFrames));
+
+/**
+ * @brief Spustí sériovou linku
+ * 
+ */
+void initProtocol() {
+    Serial.begin(PROTOCOL_BAUD_RATE);
+}
+
+/**
+ * @brief Zahodí rozpracovaný rámec a započítá ho jako chybný
+ */
+void dropFrame() {
+    parserState = WAIT_START;
+    badFrames++;
+}
+
+/**
+ * @brief Přidá přijatý bajt do rámce
+ * 
+ * @param data Přijatý bajt
+ * @return true Pokud je rámec celý a jeho CRC sedí
+ */
+bool parseByte(uint8_t data) {
+    switch (parserState) {
+        case WAIT_START:
+            if (data == PROTOCOL_START_BYTE) {
+                frameIndex = FRAME_LENGTH;
+                parserState = WAIT_LENGTH;
+            }
+            return false;
+        case WAIT_LENGTH:
+            if (data > PROTOCOL_MAX_PAYLOAD) {
+                dropFrame();
+                return false;
+            }
+            frame[frameIndex++] = data;
+            parserState = WAIT_COMMAND;
+            return false;
+        case WAIT_COMMAND:
+            frame[frameIndex++] = data;
+            parserState = frame[FRAME_LENGTH] > 0 ? WAIT_PAYLOAD : WAIT_CRC;
+            return false;
+        case WAIT_PAYLOAD:
+            frame[frameIndex++] = data;
+            if (frameIndex == FRAME_PAYLOAD + frame[FRAME_LENGTH]) {
+                parserState = WAIT_CRC;
+            }
+            return false;
+        default:
+            if (crc8(&frame[FRAME_LENGTH], frame[FRAME_LENGTH] + 2) != data) {
+                dropFrame();
+                return false;
+            }
+            parserState = WAIT_START;
+            return true;
+    }
+}
+
+/**
+ * @brief Zkontroluje hodiny, minuty a sekundy poslané v rámci
+ */
+bool isValidTime(const uint8_t* data) {
+    return data[0] < HOURS_IN_DAY && data[1] < MINUTES_IN_HOUR && data[2] < SECONDS_IN_MINUTE;
+}
+
+/**
+ * @brief Nastaví a uloží alarm, zvonící nebo odložený alarm se vypne, aby ho nové nastavení nepřepsalo
+ * 
+ * @param data Hodiny, minuty a zapnutí alarmu
+ * @param snoozeMinutes Délka odkladu v minutách
+ */
+void applyAlarm(const uint8_t* data, uint8_t snoozeMinutes) {
+    if (isAlarmRinging() || isAlarmSnoozed()) {
+        turnOffAlarm();
+    }
+    setAlarmTime({data[0], data[1], 0});
+    setAlarmStatus(data[2]);
+    setSnoozeMinutes(snoozeMinutes);
+    commitAlarmSettings();
+}
+
+/**
+ * @brief Zapíše nastavení alarmu do dat odpovědi
+ * 
+ * @return Počet zapsaných bajtů
+ */
+uint8_t writeAlarm(uint8_t* data, bool withSnooze) {
+    AlarmSettings settings = getAlarmSettings();
+    data[0] = settings.ringTime.hours;
+    data[1] = settings.ringTime.mins;
+    data[2] = settings.on;
+    if (!withSnooze) {
+        return 3;
+    }
+    data[3] = settings.snoozeMinutes;
+    return 4;
+}
+
+/**
+ * @brief Provede příkaz z rámce, data odpovědi zapíše na místo dat příkazu hned za bajt stavu
+ * 
+ * @param command Příkaz
+ * @param data Data příkazu, data odpovědi začínají na data[1]
+ * @param length Délka dat příkazu, po návratu délka dat odpovědi bez stavu
+ * @return Stav, který se pošle v odpovědi
+ */
+uint8_t runCommand(uint8_t command, uint8_t* data, uint8_t* length) {
+    uint8_t requestLength = *length;
+    *length = 0;
+    switch (command) {
+        case PROTOCOL_SET_TIME:
+            if (requestLength != 3) {
+                return PROTOCOL_BAD_LENGTH;
+            }
+            if (!isValidTime(data)) {
+                return PROTOCOL_BAD_VALUE;
+            }
+            setTime({data[0], data[1], data[2]});
+            return PROTOCOL_OK;
+        case PROTOCOL_GET_TIME: {
+            Time time = getTime();
+            data[1] = time.hours;
+            data[2] = time.mins;
+            data[3] = time.seconds;
+            *length = 3;
+            return PROTOCOL_OK;
+        }
+        case PROTOCOL_SET_ALARM:
+            if (requestLength != 3) {
+                return PROTOCOL_BAD_LENGTH;
+            }
+            if (!isValidTime(data) || data[2] > 1) {
+                return PROTOCOL_BAD_VALUE;
+            }
+            applyAlarm(data, getAlarmSettings().snoozeMinutes);
+            return PROTOCOL_OK;
+        case PROTOCOL_GET_ALARM:
+            *length = writeAlarm(&data[1], false);
+            return PROTOCOL_OK;
+        case PROTOCOL_GET_TELEMETRY: {
+            unsigned long now = millis();
+            data[1] = now;
+            data[2] = now >> 8;
+            data[3] = now >> 16;
+            data[4] = now >> 24;
+            data[5] = getBrightness();
+            data[6] = getUiState();
+            data[7] = isAlarmRinging();
+            data[8] = isAlarmSnoozed();
+            data[9] = badFrames;
+            data[10] = badFrames >> 8;
+            TimeDrift drift = getTimeDrift();
+            data[11] = drift.seconds;
+            data[12] = drift.seconds >> 8;
+            data[13] = drift.minutes;
+            data[14] = drift.resyncs;
+            data[15] = drift.resyncs >> 8;
+            *length = 15;
+            return PROTOCOL_OK;
+        }
+        case PROTOCOL_SET_CONFIG:
+            if (requestLength != 4 && requestLength != 7) {
+                return PROTOCOL_BAD_LENGTH;
+            }
+            // celé nastavení se nejdřív zkontroluje, aby se nezapsalo jen napůl
+            if (!isValidTime(data) || data[2] > 1 || data[3] < 1 || data[3] > MAX_SNOOZE_MINUTES ||
+                (requestLength == 7 && !isValidTime(&data[4]))) {
+                return PROTOCOL_BAD_VALUE;
+            }
+            applyAlarm(data, data[3]);
+            if (requestLength == 7) {
+                setTime({data[4], data[5], data[6]});
+            }
+            return PROTOCOL_OK;
+        case PROTOCOL_GET_CONFIG:
+            *length = writeAlarm(&data[1], true);
+            return PROTOCOL_OK;
+        case PROTOCOL_GET_MEMORY: {
+            MemoryStats stats = getMemoryStats();
+            data[1] = stats.staticBytes;
+            data[2] = stats.staticBytes >> 8;
+            data[3] = stats.freeBytes;
+            data[4] = stats.freeBytes >> 8;
+            data[5] = stats.stackHeadroom;
+            data[6] = stats.stackHeadroom >> 8;
+            data[7] = (uint8_t)MEMORY_HEADROOM_THRESHOLD;
+            data[8] = MEMORY_HEADROOM_THRESHOLD >> 8;
+            data[9] = isMemoryLow();
+            data[10] = getNumberOfFootprints();
+            *length = 10;
+            return PROTOCOL_OK;
+        }
+        case PROTOCOL_GET_FOOTPRINT: {
+            if (requestLength != 1) {
+                return PROTOCOL_BAD_LENGTH;
+            }
+            if (data[0] >= getNumberOfFootprints()) {
+                return PROTOCOL_BAD_VALUE;
+            }
+            uint16_t bytes = getFootprint(data[0], (char*)&data[3]);
+            data[1] = bytes;
+            data[2] = bytes >> 8;
+            *length = 2 + strlen((const char*)&data[3]);
+            return PROTOCOL_OK;
+        }
+        case PROTOCOL_GET_TRACE: {
+            uint16_t count = getTraceCount();
+            uint16_t now = getTraceTime();
+            data[1] = count;
+            data[2] = count >> 8;
+            data[3] = TRACE_LENGTH;
+            data[4] = now;
+            data[5] = now >> 8;
+            *length = 5;
+            return PROTOCOL_OK;
+        }
+        case PROTOCOL_GET_TRACE_RECORD: {
+            if (requestLength != 2) {
+                return PROTOCOL_BAD_LENGTH;
+            }
+            TraceRecord record;
+            if (!getTraceRecord(data[0] | data[1] << 8, &record)) {
+                return PROTOCOL_BAD_VALUE;
+            }
+            data[1] = record.time;
+            data[2] = record.time >> 8;
+            data[3] = record.type;
+            memcpy(&data[4], record.data, TRACE_DATA_LENGTH);
+            *length = 3 + TRACE_DATA_LENGTH;
+            return PROTOCOL_OK;
+        }
+        default:
+            return PROTOCOL_UNKNOWN_COMMAND;
+    }
+}
+
+/**
+ * @brief Provede přijatý rámec a pošle odpověď sestavenou na místě přijatého rámce
+ * 
+ * @return true Pokud příkaz něco nastavil
+ */
+bool handleFrame() {
+    uint8_t command = frame[FRAME_COMMAND];
+    uint8_t length = frame[FRAME_LENGTH];
+    uint8_t status = runCommand(command, &frame[FRAME_PAYLOAD], &length);
+    frame[FRAME_START] = PROTOCOL_START_BYTE;
+    frame[FRAME_LENGTH] = length + 1;
+    frame[FRAME_COMMAND] = command | PROTOCOL_RESPONSE_FLAG;
+    frame[FRAME_PAYLOAD] = status;
+    frame[FRAME_PAYLOAD + length + 1] = crc8(&frame[FRAME_LENGTH], length + 3);
+    Serial.write(frame, length + 1 + PROTOCOL_FRAME_OVERHEAD);
+    return status == PROTOCOL_OK && (command == PROTOCOL_SET_TIME || command == PROTOCOL_SET_ALARM ||
+                                     command == PROTOCOL_SET_CONFIG);
+}
+
+/**
+ * @brief Úloha, která zpracuje bajty přijaté po sériové lince, nejvýše PROTOCOL_MAX_BYTES_PER_RUN najednou
+ * Odpověď se zapíše celá do odesílacího bufferu, takže se na odeslání nikdy nečeká.
+ * Dokud se do bufferu nevejde nejdelší odpověď, další bajty zůstanou v přijímacím bufferu.
+ * 
+ * @return true Pokud se změnil čas nebo nastavení alarmu
+ */
+bool serviceProtocol() {
+    bool changed = false;
+    if (parserState != WAIT_START && millis() - lastByteMillis >= PROTOCOL_BYTE_TIMEOUT_MILLIS) {
+        dropFrame();
+    }
+    for (uint8_t i = 0; i < PROTOCOL_MAX_BYTES_PER_RUN; i++) {
+        if (Serial.availableForWrite() < PROTOCOL_FRAME_SIZE) {
+            break;
+        }
+        int data = Serial.read();
+        if (data < 0) {
+            break;
+        }
+        lastByteMillis = millis();
+        if (parseByte(data)) {
+            changed |= handleFrame();
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,54 @@
+#ifndef __PROTOCOL__HPP__
+#define __PROTOCOL__HPP__
+#include <Arduino.h>
+
+/**
+ * Binární protokol na sériové lince pro nastavení hodin z počítače.
+ * Rámec: PROTOCOL_START_BYTE, délka dat, příkaz, data, CRC-8 (crc8 z modulu crc) přes délku, příkaz a data.
+ * Odpověď má stejný rámec, příkaz s nastaveným bitem PROTOCOL_RESPONSE_FLAG a jako první bajt dat stav ProtocolStatus.
+ * Vícebajtová čísla se posílají od nejnižšího bajtu.
+ */
+#define PROTOCOL_BAUD_RATE 9600
+#define PROTOCOL_START_BYTE 0x7E
+#define PROTOCOL_RESPONSE_FLAG 0x80
+#define PROTOCOL_MAX_PAYLOAD 16
+/**
+ * Rámec navíc obsahuje začátek, délku, příkaz a CRC
+ */
+#define PROTOCOL_FRAME_OVERHEAD 4
+/**
+ * Pokud mezi bajty jednoho rámce uplyne víc milisekund, rozpracovaný rámec se zahodí
+ */
+#define PROTOCOL_BYTE_TIMEOUT_MILLIS 50
+/**
+ * Kolik nejvýše bajtů se zpracuje při jednom spuštění úlohy, aby úloha nezdržela ostatní
+ */
+#define PROTOCOL_MAX_BYTES_PER_RUN 32
+
+enum ProtocolCommand {
+    PROTOCOL_SET_TIME = 0x01,       // hodiny, minuty, sekundy
+    PROTOCOL_GET_TIME = 0x02,       // -> hodiny, minuty, sekundy
+    PROTOCOL_SET_ALARM = 0x03,      // hodiny, minuty, zapnuto
+    PROTOCOL_GET_ALARM = 0x04,      // -> hodiny, minuty, zapnuto
+    PROTOCOL_GET_TELEMETRY = 0x05,  // -> millis (4), jas, stav UI, zvoní, odloženo, chybné rámce (2),
+                                    //    odchylka času v sekundách (2), za kolik minut, počet měření odchylky (2)
+    PROTOCOL_SET_CONFIG = 0x06,     // hodiny, minuty, zapnuto, odklad v minutách, volitelně hodiny, minuty, sekundy času
+    PROTOCOL_GET_CONFIG = 0x07,     // -> hodiny, minuty, zapnuto, odklad v minutách
+    PROTOCOL_GET_MEMORY = 0x08,     // -> statická data (2), volná paměť (2), rezerva zásobníku (2), práh rezervy (2),
+                                    //    nedostatek paměti, počet položek rozpisu statických dat
+    PROTOCOL_GET_FOOTPRINT = 0x09,  // index položky -> velikost (2), název
+    PROTOCOL_GET_TRACE = 0x0A,      // -> počet záznamů událostí (2), délka bufferu záznamů, aktuální čas záznamů (2)
+    PROTOCOL_GET_TRACE_RECORD = 0x0B  // pořadové číslo záznamu (2) -> čas (2), druh, data (3)
+};
+
+enum ProtocolStatus {
+    PROTOCOL_OK,
+    PROTOCOL_UNKNOWN_COMMAND,
+    PROTOCOL_BAD_LENGTH,
+    PROTOCOL_BAD_VALUE
+};
+
+void initProtocol();
+bool serviceProtocol();
+
+#endif
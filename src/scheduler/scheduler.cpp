@@ -0,0 +1,112 @@
+#include "scheduler.hpp"
+
+#include <limits.h>
+
+#include "memory/memory.hpp"
+
+/**
+ * @brief Tabulka úloh a jejich počet
+ */
+Task tasks[MAX_TASKS];
+uint8_t numberOfTasks = 0;
+
+MEMORY_FOOTPRINT(scheduler, sizeof(tasks) + sizeof(numberOfTasks));
+
+/**
+ * @brief Přidá periodickou úlohu, poprvé poběží hned při nejbližším volání runTasks
+ * 
+ * @param run Funkce úlohy
+ * @param periodMillis Perioda úlohy v milisekundách
+ * @return Index úlohy pro runTaskNow a takeTaskStats
+ */
+uint8_t addTask(TaskFunction run, uint16_t periodMillis) {
+    if (numberOfTasks >= MAX_TASKS) {
+        return MAX_TASKS;
+    }
+    tasks[numberOfTasks] = {
+        .run = run,
+        .periodMillis = periodMillis,
+        .nextRun = millis(),
+        .maxLatenessMillis = 0,
+        .missedDeadlines = 0};
+    return numberOfTasks++;
+}
+
+/**
+ * @brief Spustí všechny úlohy, kterým už nastal termín
+ * Zpoždění úlohy se zaznamená. Úloha, která se zpozdila o celou periodu, zmeškala termín,
+ * zmeškané běhy se nedohánějí a úloha pokračuje s novou fází od aktuálního času.
+ * 
+ */
+void runTasks() {
+    for (uint8_t i = 0; i < numberOfTasks; i++) {
+        Task* task = &tasks[i];
+        unsigned long now = millis();
+        long lateness = (long)(now - task->nextRun);
+        if (lateness < 0) {
+            continue;
+        }
+        if (lateness > task->maxLatenessMillis) {
+            task->maxLatenessMillis = lateness < UINT16_MAX ? lateness : UINT16_MAX;
+        }
+        if (lateness >= task->periodMillis) {
+            task->missedDeadlines++;
+            task->nextRun = now + task->periodMillis;
+        } else {
+            task->nextRun += task->periodMillis;
+        }
+        task->run();
+    }
+}
+
+/**
+ * @brief Naplánuje úlohu na nejbližší volání runTasks, její další běhy pak pokračují s periodou od teď
+ * 
+ * @param task Index úlohy z addTask
+ */
+void runTaskNow(uint8_t task) {
+    if (task < numberOfTasks) {
+        tasks[task].nextRun = millis();
+    }
+}
+
+/**
+ * @brief Spočítá, jak dlouho procesor může spát do termínu nejbližší úlohy
+ * 
+ * @return Počet milisekund do nejbližšího termínu, 0 pokud některá úloha už čeká
+ */
+unsigned long millisUntilNextTask() {
+    unsigned long now = millis();
+    unsigned long until = ULONG_MAX;
+    for (uint8_t i = 0; i < numberOfTasks; i++) {
+        long remaining = (long)(tasks[i].nextRun - now);
+        if (remaining <= 0) {
+            return 0;
+        }
+        if ((unsigned long)remaining < until) {
+            until = remaining;
+        }
+    }
+    return until;
+}
+
+/**
+ * @brief Vrátí počet přidaných úloh
+ * @return Počet úloh
+ */
+uint8_t getNumberOfTasks() {
+    return numberOfTasks;
+}
+
+/**
+ * @brief Vrátí úlohu s jejím největším zpožděním a počtem zmeškaných termínů od posledního volání a obojí vynuluje
+ * 
+ * @param task Index úlohy z addTask
+ * @return Kopie úlohy včetně statistik
+ */
+Task takeTaskStats(uint8_t task) {
+    Task stats = tasks[task];
+    tasks[task].maxLatenessMillis = 0;
+    tasks[task].missedDeadlines = 0;
+    return stats;
+}
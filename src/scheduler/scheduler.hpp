@@ -0,0 +1,34 @@
+#ifndef __SCHEDULER__HPP__
+#define __SCHEDULER__HPP__
+#include <Arduino.h>
+
+/**
+ * Kooperativní plánovač periodických úloh hlavní smyčky.
+ * Každá úloha má svou periodu v milisekundách a běží vždy celá, úlohy se navzájem nepřerušují.
+ * Úlohy se stejným termínem běží v pořadí, v jakém byly přidány.
+ */
+#ifndef MAX_TASKS
+#define MAX_TASKS 8
+#endif
+
+typedef void (*TaskFunction)();
+
+/**
+ * Úloha plánovače, termín nextRun se posouvá o periodu, takže úloha drží stálou fázi
+ */
+struct Task {
+    TaskFunction run;
+    uint16_t periodMillis;
+    unsigned long nextRun;
+    uint16_t maxLatenessMillis;
+    uint16_t missedDeadlines;
+};
+
+uint8_t addTask(TaskFunction run, uint16_t periodMillis);
+void runTasks();
+void runTaskNow(uint8_t task);
+unsigned long millisUntilNextTask();
+uint8_t getNumberOfTasks();
+Task takeTaskStats(uint8_t task);
+
+#endif
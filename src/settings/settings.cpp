@@ -0,0 +1,193 @@
+#include "settings.hpp"
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <avr/eeprom.h>
+
+#include "crc/crc.hpp"
+#include "memory/memory.hpp"
+
+/**
+ * @brief Adresa a hodnota magického čísla, kterým starší verze programu označovala svá data v EEPROM
+ * Data ve starém formátu se při prvním načtení převedou na záznam nastavení.
+ */
+#define LEGACY_MAGIC_NUMBER 23
+enum LegacyEepromAddresses {
+    LEGACY_MAGIC_NUMBER_ADDRESS,
+    LEGACY_ALARM_STATUS_ADDRESS,
+    LEGACY_ALARM_HOURS_ADDRESS,
+    LEGACY_ALARM_MINUTES_ADDRESS
+};
+
+/**
+ * @brief Slot s nejnovějším platným záznamem a jeho pořadové číslo
+ */
+uint8_t currentSlot = SETTINGS_SLOTS - 1;
+uint16_t currentSequence = 0;
+
+/**
+ * @brief Nastavení, které je uložené (nebo se právě ukládá) v EEPROM, podle něj se přeskakují zbytečné zápisy
+ */
+AlarmSettings savedSettings;
+
+/**
+ * @brief Záznam, který se po bajtech zapisuje do EEPROM, a index dalšího bajtu, SETTINGS_RECORD_SIZE znamená, že se nic nezapisuje
+ */
+SettingsRecord pendingRecord;
+uint8_t pendingSlot;
+uint8_t pendingIndex = SETTINGS_RECORD_SIZE;
+
+MEMORY_FOOTPRINT(settings, sizeof(currentSlot) + sizeof(currentSequence) + sizeof(savedSettings) +
+                 sizeof(pendingRecord) + sizeof(pendingSlot) + sizeof(pendingIndex));
+
+/**
+ * @brief Přečte záznam ze slotu v EEPROM
+ * 
+ * @param slot Index slotu
+ * @param record Kam se záznam uloží
+ */
+void readRecord(uint8_t slot, SettingsRecord* record) {
+    uint8_t* bytes = (uint8_t*)record;
+    uint16_t address = slot * SETTINGS_RECORD_SIZE;
+    for (uint8_t i = 0; i < SETTINGS_RECORD_SIZE; i++) {
+        bytes[i] = EEPROM.read(address + i);
+    }
+}
+
+/**
+ * @brief Zkontroluje verzi a CRC záznamu
+ * 
+ * @param record Záznam přečtený z EEPROM
+ * @return true Pokud je záznam celý a v podporované verzi
+ */
+bool isRecordValid(const SettingsRecord* record) {
+    return record->version >= SETTINGS_OLDEST_VERSION && record->version <= SETTINGS_VERSION &&
+           crc8((const uint8_t*)record, SETTINGS_RECORD_SIZE - 1) == record->crc;
+}
+
+/**
+ * @brief Porovná dvě nastavení budíku
+ * 
+ * @return true Pokud jsou nastavení stejná
+ */
+bool isSameSettings(AlarmSettings first, AlarmSettings second) {
+    return first.ringTime.hours == second.ringTime.hours &&
+           first.ringTime.mins == second.ringTime.mins &&
+           first.on == second.on &&
+           first.snoozeMinutes == second.snoozeMinutes;
+}
+
+/**
+ * @brief Najde v EEPROM nejnovější platný záznam nastavení a načte z něj nastavení budíku
+ * Za nejnovější se považuje záznam s nejvyšším pořadovým číslem, porovnání počítá s přetečením čísla.
+ * 
+ * @param alarmSettings Kam se nastavení uloží
+ * @return true Pokud byl nalezen platný záznam
+ * @return false Pokud EEPROM žádný platný záznam neobsahuje, nastavení pak zůstane beze změny
+ */
+bool loadSettings(AlarmSettings* alarmSettings) {
+    bool found = false;
+    SettingsRecord record;
+    SettingsRecord newest = {};
+    for (uint8_t slot = 0; slot < SETTINGS_SLOTS; slot++) {
+        readRecord(slot, &record);
+        if (isRecordValid(&record) && (!found || (int16_t)(record.sequence - newest.sequence) > 0)) {
+            newest = record;
+            currentSlot = slot;
+            found = true;
+        }
+    }
+    if (found) {
+        currentSequence = newest.sequence;
+        alarmSettings->ringTime.hours = newest.alarmHours;
+        alarmSettings->ringTime.mins = newest.alarmMins;
+        alarmSettings->ringTime.seconds = 0;
+        alarmSettings->on = newest.alarmOn;
+        // záznam verze 1 má na místě délky odkladu nulu
+        bool validSnooze = newest.snoozeMinutes >= 1 && newest.snoozeMinutes <= MAX_SNOOZE_MINUTES;
+        alarmSettings->snoozeMinutes = validSnooze ? newest.snoozeMinutes : DEFAULT_SNOOZE_MINUTES;
+        savedSettings = *alarmSettings;
+    } else if (EEPROM.read(LEGACY_MAGIC_NUMBER_ADDRESS) == LEGACY_MAGIC_NUMBER) {
+        uint8_t hours = EEPROM.read(LEGACY_ALARM_HOURS_ADDRESS);
+        uint8_t mins = EEPROM.read(LEGACY_ALARM_MINUTES_ADDRESS);
+        if (hours >= HOURS_IN_DAY || mins >= MINUTES_IN_HOUR) {
+            return false;
+        }
+        alarmSettings->ringTime.hours = hours;
+        alarmSettings->ringTime.mins = mins;
+        alarmSettings->ringTime.seconds = 0;
+        alarmSettings->on = EEPROM.read(LEGACY_ALARM_STATUS_ADDRESS) == 1;
+        alarmSettings->snoozeMinutes = DEFAULT_SNOOZE_MINUTES;
+        // stará data leží ve slotu 0, převedený záznam jde do slotu 1, aby je nepřepsal dřív, než bude celý
+        currentSlot = 0;
+        saveSettings(*alarmSettings);
+        found = true;
+    }
+    return found;
+}
+
+/**
+ * @brief Naplánuje uložení nastavení do dalšího slotu, samotný zápis pak po bajtech provádí serviceSettings
+ * Pokud je nastavení stejné jako naposledy uložené, nic se nezapisuje.
+ * Pokud se předchozí záznam ještě zapisuje, nový záznam ho nahradí ve stejném slotu.
+ * 
+ * @param alarmSettings Nastavení budíku
+ */
+void saveSettings(AlarmSettings alarmSettings) {
+    bool writing = isSettingsWritePending();
+    if (!writing && isSameSettings(alarmSettings, savedSettings)) {
+        return;
+    }
+    if (!writing) {
+        pendingSlot = currentSlot + 1 < SETTINGS_SLOTS ? currentSlot + 1 : 0;
+        pendingRecord.sequence = currentSequence + 1;
+    }
+    pendingRecord.version = SETTINGS_VERSION;
+    pendingRecord.alarmHours = alarmSettings.ringTime.hours;
+    pendingRecord.alarmMins = alarmSettings.ringTime.mins;
+    pendingRecord.alarmOn = alarmSettings.on;
+    pendingRecord.snoozeMinutes = alarmSettings.snoozeMinutes;
+    memset(pendingRecord.reserved, 0, sizeof(pendingRecord.reserved));
+    pendingRecord.crc = crc8((const uint8_t*)&pendingRecord, SETTINGS_RECORD_SIZE - 1);
+    pendingIndex = 0;
+    savedSettings = alarmSettings;
+}
+
+/**
+ * @brief Pokračuje v zápisu naplánovaného záznamu, volá se z hlavní smyčky
+ * Zapíše nejvýše jeden bajt a jen tehdy, když EEPROM dokončila předchozí zápis, takže nikdy nečeká.
+ * Bajty, které už v EEPROM mají správnou hodnotu, se přeskočí a buňku vůbec neopotřebují.
+ * 
+ */
+void serviceSettings() {
+    if (!isSettingsWritePending()) {
+        return;
+    }
+    const uint8_t* bytes = (const uint8_t*)&pendingRecord;
+    uint16_t slotAddress = pendingSlot * SETTINGS_RECORD_SIZE;
+    while (pendingIndex < SETTINGS_RECORD_SIZE) {
+        if (!eeprom_is_ready()) {
+            return;
+        }
+        uint16_t address = slotAddress + pendingIndex;
+        uint8_t value = bytes[pendingIndex];
+        pendingIndex++;
+        if (EEPROM.read(address) != value) {
+            EEPROM.write(address, value);
+            break;
+        }
+    }
+    if (pendingIndex == SETTINGS_RECORD_SIZE) {
+        currentSlot = pendingSlot;
+        currentSequence = pendingRecord.sequence;
+    }
+}
+
+/**
+ * @brief Zjistí, zdali se ještě zapisuje záznam nastavení
+ * 
+ * @return true Pokud zápis ještě neskončil
+ */
+bool isSettingsWritePending() {
+    return pendingIndex < SETTINGS_RECORD_SIZE;
+}
@@ -0,0 +1,42 @@
+#ifndef __SETTINGS__HPP__
+#define __SETTINGS__HPP__
+#include <Arduino.h>
+
+#include "time/time.hpp"
+
+/**
+ * Verze záznamu nastavení, při změně struktury záznamu se zvýší
+ * Záznamy od verze SETTINGS_OLDEST_VERSION se načtou, položky, které v nich ještě nebyly, dostanou výchozí hodnotu.
+ * Verze 2 přidala délku odkladu buzení.
+ */
+#define SETTINGS_VERSION 2
+#define SETTINGS_OLDEST_VERSION 1
+/**
+ * Záznamy se zapisují postupně do všech slotů v EEPROM, každý zápis jde do dalšího slotu,
+ * takže se jednotlivé buňky opotřebovávají SETTINGS_SLOTS krát pomaleji
+ */
+#define SETTINGS_RECORD_SIZE 16
+#define SETTINGS_SLOTS ((E2END + 1) / SETTINGS_RECORD_SIZE)
+
+/**
+ * Jeden záznam nastavení v EEPROM, CRC je poslední, takže se zapisuje až po všech datech
+ */
+struct SettingsRecord {
+    uint16_t sequence;
+    uint8_t version;
+    uint8_t alarmHours;
+    uint8_t alarmMins;
+    uint8_t alarmOn;
+    uint8_t snoozeMinutes;
+    uint8_t reserved[SETTINGS_RECORD_SIZE - 8];
+    uint8_t crc;
+};
+
+static_assert(sizeof(SettingsRecord) == SETTINGS_RECORD_SIZE, "SettingsRecord has to fill exactly one slot");
+
+bool loadSettings(AlarmSettings* alarmSettings);
+void saveSettings(AlarmSettings alarmSettings);
+void serviceSettings();
+bool isSettingsWritePending();
+
+#endif
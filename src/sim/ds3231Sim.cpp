@@ -0,0 +1,276 @@
+#include "sim/ds3231Sim.hpp"
+
+#include <Arduino.h>
+
+#include "sim/sim.hpp"
+#include "time/rtc.hpp"
+
+#define HALF_SECOND_MICROS 500000ULL
+
+/**
+ * @brief Registry čipu, ukazatel na aktuální registr a stav pinu SQW při výstupu obdélníku 1 Hz
+ */
+uint8_t ds3231Registers[DS3231_SIM_REGISTERS];
+uint8_t ds3231Pointer = 0;
+bool ds3231SquareWave = true;
+bool ds3231Responding = true;
+
+/**
+ * @brief Kopie registrů z podmínky START, ze které se čte, a zdali čip čeká na adresu registru jako první zapsaný bajt
+ */
+uint8_t ds3231Snapshot[DS3231_SIM_REGISTERS];
+bool ds3231PointerExpected = false;
+
+/**
+ * @brief Čas další půlsekundy, kdy se přepíná SQW a na celé sekundě se posouvá čas
+ */
+uint64_t ds3231NextHalfSecond = HALF_SECOND_MICROS;
+/**
+ * @brief Délka půlsekundy čipu, odchylka od HALF_SECOND_MICROS simuluje krystal čipu, který jde jinak než krystal procesoru
+ */
+uint64_t ds3231HalfSecondMicros = HALF_SECOND_MICROS;
+uint32_t ds3231Days = 0;
+uint32_t ds3231TransactionCount = 0;
+
+static uint8_t toBcd(uint8_t value) {
+    return ((value / 10) << 4) | (value % 10);
+}
+
+static uint8_t fromBcd(uint8_t bcd) {
+    return (bcd >> 4) * 10 + (bcd & 0x0F);
+}
+
+/**
+ * @brief Spočítá úroveň pinu INT/SQW a předá ji simulátoru
+ */
+static void updateInterruptPin() {
+    uint8_t control = ds3231Registers[DS3231_CONTROL_REGISTER];
+    uint8_t status = ds3231Registers[DS3231_STATUS_REGISTER];
+    bool level;
+    if (control & DS3231_INTCN) {
+        bool active = ((status & DS3231_A1F) && (control & DS3231_A1IE)) ||
+                      ((status & DS3231_A2F) && (control & DS3231_A2IE));
+        level = !active;
+    } else {
+        level = ds3231SquareWave;
+    }
+    simSetInputPin(RTC_INT_PIN, level);
+}
+
+/**
+ * @brief Porovná alarm 1 nebo 2 s časem po posunu o sekundu podle masek AxMy
+ * 
+ * @param first Adresa prvního registru alarmu
+ * @param withSeconds True pro alarm 1, který má i registr sekund
+ * @return true Pokud alarm nastal
+ */
+static bool isAlarmMatching(uint8_t first, bool withSeconds) {
+    const uint8_t* alarm = &ds3231Registers[first];
+    if (!withSeconds && ds3231Registers[DS3231_SECONDS_REGISTER] != 0) {
+        return false;
+    }
+    uint8_t index = 0;
+    uint8_t timeRegister = withSeconds ? DS3231_SECONDS_REGISTER : DS3231_MINUTES_REGISTER;
+    for (; timeRegister <= DS3231_HOURS_REGISTER; timeRegister++, index++) {
+        if (!(alarm[index] & DS3231_ALARM_MASK_BIT) && (alarm[index] & 0x7F) != ds3231Registers[timeRegister]) {
+            return false;
+        }
+    }
+    uint8_t day = alarm[index];
+    if (!(day & DS3231_ALARM_MASK_BIT)) {
+        uint8_t expected = day & 0x40 ? ds3231Registers[0x03] : ds3231Registers[0x04];
+        if ((day & 0x3F) != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Posune čas čipu o jednu sekundu a vyhodnotí alarmy
+ */
+static void tickSecond() {
+    static const uint8_t daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    uint8_t* r = ds3231Registers;
+    uint8_t seconds = fromBcd(r[0]) + 1;
+    uint8_t mins = fromBcd(r[1]);
+    uint8_t hours = fromBcd(r[2] & DS3231_HOURS_MASK);
+    if (seconds == 60) {
+        seconds = 0;
+        mins++;
+    }
+    if (mins == 60) {
+        mins = 0;
+        hours++;
+    }
+    if (hours == 24) {
+        hours = 0;
+        ds3231Days++;
+        r[3] = r[3] % 7 + 1;
+        uint8_t date = fromBcd(r[4]) + 1;
+        uint8_t month = fromBcd(r[5] & 0x1F);
+        if (date > daysInMonth[(month + 11) % 12]) {
+            date = 1;
+            month = month % 12 + 1;
+        }
+        r[4] = toBcd(date);
+        r[5] = toBcd(month);
+    }
+    r[0] = toBcd(seconds);
+    r[1] = toBcd(mins);
+    r[2] = toBcd(hours);
+    if (isAlarmMatching(0x07, true)) {
+        r[DS3231_STATUS_REGISTER] |= DS3231_A1F;
+    }
+    if (isAlarmMatching(DS3231_ALARM2_MINUTES_REGISTER, false)) {
+        r[DS3231_STATUS_REGISTER] |= DS3231_A2F;
+    }
+}
+
+static uint64_t ds3231NextEvent() {
+    return ds3231NextHalfSecond;
+}
+
+static void ds3231Fire(uint64_t now) {
+    ds3231NextHalfSecond = now + ds3231HalfSecondMicros;
+    ds3231SquareWave = !ds3231SquareWave;
+    if (!ds3231SquareWave) {
+        tickSecond();
+    }
+    updateInterruptPin();
+}
+
+/**
+ * @brief Nastaví počáteční čas čipu a zaregistruje čip v simulátoru
+ * 
+ * @param lostPower True pokud má čip po startu nastavený příznak OSF jako po výměně baterie
+ */
+void initDs3231Sim(uint8_t hours, uint8_t mins, uint8_t seconds, bool lostPower) {
+    memset(ds3231Registers, 0, sizeof(ds3231Registers));
+    ds3231Registers[0] = toBcd(seconds);
+    ds3231Registers[1] = toBcd(mins);
+    ds3231Registers[2] = toBcd(hours);
+    ds3231Registers[3] = 1;
+    ds3231Registers[4] = 1;
+    ds3231Registers[5] = 1;
+    ds3231Registers[DS3231_CONTROL_REGISTER] = 0x1C;
+    ds3231Registers[DS3231_STATUS_REGISTER] = lostPower ? DS3231_OSF : 0;
+    ds3231Registers[DS3231_TEMPERATURE_REGISTER] = 22;
+    simSetInputPin(RTC_INT_PIN, true);
+    SimDevice device = {ds3231NextEvent, ds3231Fire};
+    simAddDevice(device);
+}
+
+uint32_t ds3231SimSecondsOfDay() {
+    uint8_t* r = ds3231Registers;
+    return fromBcd(r[2] & DS3231_HOURS_MASK) * 3600UL + fromBcd(r[1]) * 60UL + fromBcd(r[0]);
+}
+
+uint32_t ds3231SimDays() {
+    return ds3231Days;
+}
+
+uint8_t ds3231SimRegister(uint8_t address) {
+    return ds3231Registers[address];
+}
+
+uint32_t ds3231SimTransactions() {
+    return ds3231TransactionCount;
+}
+
+/**
+ * @brief Nastaví, o kolik miliontin jde čip pomaleji než procesor (záporná hodnota znamená rychleji)
+ */
+void ds3231SimSetSlowdownPpm(int32_t ppm) {
+    ds3231HalfSecondMicros = HALF_SECOND_MICROS + HALF_SECOND_MICROS * ppm / 1000000;
+    ds3231NextHalfSecond = ds3231HalfSecondMicros;
+}
+
+/**
+ * @brief Nastaví teplotu čidla čipu, zaokrouhlí se na čtvrtiny °C jako v čipu
+ */
+void ds3231SimSetTemperature(double degrees) {
+    int16_t quarters = (int16_t)(degrees * 4 + (degrees < 0 ? -0.5 : 0.5));
+    ds3231Registers[DS3231_TEMPERATURE_REGISTER] = (uint8_t)(quarters >> 2);
+    ds3231Registers[DS3231_TEMPERATURE_REGISTER + 1] = (uint8_t)((quarters & 0x03) << 6);
+}
+
+void ds3231SimSetResponding(bool responding) {
+    ds3231Responding = responding;
+}
+
+/**
+ * @brief Zapíše registr tak, jak by to udělal čip: zápis sekund nuluje dělič a příznaky lze jen mazat
+ */
+static void writeRegister(uint8_t address, uint8_t value) {
+    if (address >= DS3231_SIM_REGISTERS) {
+        return;
+    }
+    if (address == DS3231_STATUS_REGISTER) {
+        uint8_t flags = DS3231_OSF | DS3231_A2F | DS3231_A1F;
+        uint8_t current = ds3231Registers[address];
+        ds3231Registers[address] = (value & ~flags) | (current & value & flags);
+    } else if (address >= DS3231_TEMPERATURE_REGISTER) {
+        return;  // teplota je jen pro čtení
+    } else {
+        ds3231Registers[address] = value;
+    }
+    if (address == DS3231_SECONDS_REGISTER) {
+        ds3231NextHalfSecond = simMicros() + ds3231HalfSecondMicros;
+        ds3231SquareWave = true;
+    }
+}
+
+/**
+ * @brief Podmínka START s adresou na sběrnici, čip si zkopíruje registry, takže se čtené hodnoty během přenosu nezmění
+ * 
+ * @param address 7bitová adresa z bajtu SLA+R/W
+ * @return true Pokud čip adresu potvrdil
+ */
+bool ds3231SimSelect(uint8_t address) {
+    if (address != DS3231_ADDRESS || !ds3231Responding) {
+        return false;
+    }
+    ds3231TransactionCount++;
+    memcpy(ds3231Snapshot, ds3231Registers, sizeof(ds3231Snapshot));
+    ds3231PointerExpected = true;
+    return true;
+}
+
+/**
+ * @brief Zapsaný bajt, první po adrese nastaví ukazatel na registr, další se zapisují do registrů
+ * 
+ * @return true Pokud čip bajt potvrdil
+ */
+bool ds3231SimWrite(uint8_t data) {
+    if (!ds3231Responding) {
+        return false;
+    }
+    if (ds3231PointerExpected) {
+        ds3231Pointer = data % DS3231_SIM_REGISTERS;
+        ds3231PointerExpected = false;
+        return true;
+    }
+    writeRegister(ds3231Pointer, data);
+    ds3231Pointer = (ds3231Pointer + 1) % DS3231_SIM_REGISTERS;
+    return true;
+}
+
+/**
+ * @brief Čtený bajt z kopie registrů pořízené při podmínce START
+ */
+uint8_t ds3231SimRead() {
+    if (!ds3231Responding) {
+        return 0xFF;
+    }
+    uint8_t data = ds3231Snapshot[ds3231Pointer];
+    ds3231Pointer = (ds3231Pointer + 1) % DS3231_SIM_REGISTERS;
+    return data;
+}
+
+/**
+ * @brief Podmínka STOP, zapsané příznaky a kontrolní registr se projeví na pinu INT
+ */
+void ds3231SimStop() {
+    updateInterruptPin();
+}
@@ -0,0 +1,23 @@
+#ifndef __DS3231__SIM__HPP__
+#define __DS3231__SIM__HPP__
+#include <stdint.h>
+
+/**
+ * Model čipu DS3231 na sběrnici I2C simulátoru: registry času a alarmů, příznaky OSF/A1F/A2F a pin INT/SQW
+ */
+#define DS3231_SIM_REGISTERS 0x13
+
+void initDs3231Sim(uint8_t hours, uint8_t mins, uint8_t seconds, bool lostPower);
+uint32_t ds3231SimSecondsOfDay();
+uint32_t ds3231SimDays();
+uint8_t ds3231SimRegister(uint8_t address);
+uint32_t ds3231SimTransactions();
+void ds3231SimSetSlowdownPpm(int32_t ppm);
+void ds3231SimSetTemperature(double degrees);
+void ds3231SimSetResponding(bool responding);
+bool ds3231SimSelect(uint8_t address);
+bool ds3231SimWrite(uint8_t data);
+uint8_t ds3231SimRead();
+void ds3231SimStop();
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef __SIM__ARDUINO__H__
+#define __SIM__ARDUINO__H__
+/**
+ * Náhrada Arduino.h pro nativní build (prostředí native), poskytuje jen to, co program hodin používá.
+ * Čas, přerušení a periferie obsluhuje simulátor v src/sim.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define _BV(bit) (1 << (bit))
+#define bit(b) (1UL << (b))
+#define noInterrupts() cli()
+#define interrupts() sei()
+#undef abs
+#define abs(x) ((x) > 0 ? (x) : -(x))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+static const uint8_t A0 = 14;
+static const uint8_t A1 = 15;
+static const uint8_t A2 = 16;
+static const uint8_t A3 = 17;
+static const uint8_t A4 = 18;
+static const uint8_t A5 = 19;
+static const uint8_t SS = 10;
+static const uint8_t MOSI = 11;
+static const uint8_t MISO = 12;
+static const uint8_t SCK = 13;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+class __FlashStringHelper;
+#define F(string) (reinterpret_cast<const __FlashStringHelper*>(string))
+
+/**
+ * Sériová linka simulátoru, výstup jde na standardní výstup
+ */
+class HardwareSerial {
+   public:
+    void begin(unsigned long baud);
+    void end();
+    int available();
+    int read();
+    int peek();
+    int availableForWrite();
+    void flush();
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t length);
+    size_t print(const char* text);
+    size_t print(const __FlashStringHelper* text);
+    size_t print(char character);
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t print(int value);
+    size_t print(unsigned int value);
+    size_t println(const char* text);
+    size_t println(const __FlashStringHelper* text);
+    size_t println(long value);
+    size_t println(unsigned long value);
+    size_t println(int value);
+    size_t println(unsigned int value);
+    size_t println();
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
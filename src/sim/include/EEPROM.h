@@ -0,0 +1,21 @@
+#ifndef __SIM__EEPROM__H__
+#define __SIM__EEPROM__H__
+#include <stdint.h>
+
+#include <avr/eeprom.h>
+#include <avr/io.h>
+
+/**
+ * EEPROM simulátoru, obsah lze načíst ze souboru a na konci simulace ho tam zase uložit
+ */
+class EEPROMClass {
+   public:
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    void update(int address, uint8_t value);
+    uint16_t length() { return E2END + 1; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef __SIM__AVR__EEPROM__H__
+#define __SIM__AVR__EEPROM__H__
+
+/**
+ * Zápis do EEPROM je v simulátoru okamžitý
+ */
+inline bool eeprom_is_ready() {
+    return true;
+}
+
+#endif
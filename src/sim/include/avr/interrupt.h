@@ -0,0 +1,14 @@
+#ifndef __SIM__AVR__INTERRUPT__H__
+#define __SIM__AVR__INTERRUPT__H__
+/**
+ * Obsluha přerušení je v simulátoru obyčejná funkce, kterou simulátor volá ve chvíli, kdy by přerušení nastalo.
+ * Aliasy vektorů simulátor neřeší, všechny skupiny přerušení při změně pinu volají PCINT0_vect.
+ */
+#define ISR(vector, ...) extern "C" void vector(void)
+#define ISR_ALIASOF(vector)
+#define ISR_NOBLOCK
+
+void cli();
+void sei();
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef __SIM__AVR__IO__H__
+#define __SIM__AVR__IO__H__
+/**
+ * Registry ATmega328 v simulátoru jsou obyčejné proměnné, simulátor je čte a podle nich řídí časovače a piny
+ */
+#include <stdint.h>
+
+#define SIM_REGISTER(name) extern volatile uint8_t name;
+SIM_REGISTER(PINB)
+SIM_REGISTER(DDRB)
+SIM_REGISTER(PORTB)
+SIM_REGISTER(PINC)
+SIM_REGISTER(DDRC)
+SIM_REGISTER(PORTC)
+SIM_REGISTER(PIND)
+SIM_REGISTER(DDRD)
+SIM_REGISTER(PORTD)
+SIM_REGISTER(TCCR0A)
+SIM_REGISTER(TCCR0B)
+SIM_REGISTER(TIMSK0)
+SIM_REGISTER(TCCR1A)
+SIM_REGISTER(TCCR1B)
+SIM_REGISTER(TIMSK1)
+SIM_REGISTER(TIFR1)
+SIM_REGISTER(TCCR2A)
+SIM_REGISTER(TCCR2B)
+SIM_REGISTER(TCNT2)
+SIM_REGISTER(OCR2A)
+SIM_REGISTER(OCR2B)
+SIM_REGISTER(TIMSK2)
+SIM_REGISTER(TIFR2)
+SIM_REGISTER(ASSR)
+SIM_REGISTER(PCICR)
+SIM_REGISTER(PCIFR)
+SIM_REGISTER(PCMSK0)
+SIM_REGISTER(PCMSK1)
+SIM_REGISTER(PCMSK2)
+SIM_REGISTER(EICRA)
+SIM_REGISTER(EIMSK)
+SIM_REGISTER(SPCR)
+SIM_REGISTER(SPSR)
+SIM_REGISTER(SPDR)
+SIM_REGISTER(TWBR)
+SIM_REGISTER(TWSR)
+SIM_REGISTER(TWAR)
+SIM_REGISTER(TWDR)
+SIM_REGISTER(ADCSRA)
+SIM_REGISTER(ACSR)
+SIM_REGISTER(SMCR)
+SIM_REGISTER(MCUSR)
+SIM_REGISTER(PRR)
+SIM_REGISTER(SREG)
+#undef SIM_REGISTER
+extern volatile uint16_t TCNT1;
+extern volatile uint16_t OCR1A;
+
+/**
+ * Zápis do TWCR spouští akce periferie TWI (START, bajt, STOP), proto ho simulátor zachytí, viz sim/twiSim.cpp
+ */
+class SimTwiControl {
+   public:
+    SimTwiControl& operator=(uint8_t value);
+    operator uint8_t() const {
+        return value;
+    }
+    uint8_t value;
+};
+extern SimTwiControl TWCR;
+
+#define _BV(bit) (1 << (bit))
+#define SREG_I 7
+
+#define E2END 0x3FF
+#define RAMEND 0x8FF
+
+#define WGM21 1
+#define CS20 0
+#define CS21 1
+#define CS22 2
+#define OCIE2A 1
+#define OCIE2B 2
+#define OCF2A 1
+#define OCF2B 2
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define TOIE1 0
+#define TOV1 0
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+#define SPIE 7
+#define SPE 6
+#define DORD 5
+#define MSTR 4
+#define SPI2X 0
+#define SPIF 7
+#define TWINT 7
+#define TWEA 6
+#define TWSTA 5
+#define TWSTO 4
+#define TWWC 3
+#define TWEN 2
+#define TWIE 0
+#define TWPS0 0
+#define TWPS1 1
+#define ACD 7
+#define PRTWI 7
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef __SIM__AVR__PGMSPACE__H__
+#define __SIM__AVR__PGMSPACE__H__
+/**
+ * Flash a RAM mají v simulátoru společný adresní prostor, čtení z flash je obyčejné čtení
+ */
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(string) (string)
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+#define pgm_read_ptr(address) (*(void* const*)(address))
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef __SIM__AVR__POWER__H__
+#define __SIM__AVR__POWER__H__
+
+inline void power_adc_disable() {}
+inline void power_spi_disable() {}
+inline void power_timer1_disable() {}
+inline void power_twi_disable() {}
+
+#endif
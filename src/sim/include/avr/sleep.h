@@ -0,0 +1,18 @@
+#ifndef __SIM__AVR__SLEEP__H__
+#define __SIM__AVR__SLEEP__H__
+#include <stdint.h>
+/**
+ * Spánek v simulátoru posune virtuální čas až k přerušení, které by procesor probudilo
+ */
+#define SLEEP_MODE_IDLE 0
+#define SLEEP_MODE_ADC 1
+#define SLEEP_MODE_PWR_DOWN 2
+#define SLEEP_MODE_PWR_SAVE 3
+
+void set_sleep_mode(uint8_t mode);
+void sleep_cpu();
+inline void sleep_enable() {}
+inline void sleep_disable() {}
+inline void sleep_bod_disable() {}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef __SIM__UTIL__ATOMIC__H__
+#define __SIM__UTIL__ATOMIC__H__
+/**
+ * ATOMIC_BLOCK z avr-libc pro simulátor, bit I registru SREG udržují funkce cli a sei
+ */
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+static inline uint8_t simAtomicEnter() {
+    cli();
+    return 1;
+}
+
+static inline void simAtomicRestore(const uint8_t* state) {
+    if (*state & _BV(SREG_I)) {
+        sei();
+    } else {
+        cli();
+    }
+}
+
+static inline void simAtomicForceOn(const uint8_t*) {
+    sei();
+}
+
+#define ATOMIC_RESTORESTATE uint8_t simAtomicState __attribute__((__cleanup__(simAtomicRestore))) = SREG
+#define ATOMIC_FORCEON uint8_t simAtomicState __attribute__((__cleanup__(simAtomicForceOn))) = 0
+#define ATOMIC_BLOCK(type) for (type, simAtomicToDo = simAtomicEnter(); simAtomicToDo; simAtomicToDo = 0)
+
+#endif
@@ -0,0 +1,190 @@
+#include "sim/panelSim.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Arduino.h>
+
+#include "buzzer/buzzer.hpp"
+#include "display/font.hpp"
+#include "gpio/gpio.hpp"
+#include "sim/ds3231Sim.hpp"
+#include "sim/sim.hpp"
+#include "time/time.hpp"
+
+typedef GpioPin<SER> SerPin;
+typedef GpioPin<RCLK> RclkPin;
+typedef GpioPin<SRCLK> SrclkPin;
+typedef GpioPin<DOTS_PIN> DotsPin;
+typedef GpioPin<ALARM_PIN> BuzzerPin;
+
+/**
+ * Bzučák se považuje za umlčený, když pin tak dlouho nesepnul, delší než nejdelší pauza ve vzoru pípání
+ */
+#define PANEL_SIM_BUZZER_SILENCE_MICROS 1000000ULL
+
+static const uint8_t digitPins[NUMBER_OF_DIGITS] = {
+    HOURS_FIRST_DIGIT_PIN, HOURS_SECOND_DIGIT_PIN, MINUTES_FIRST_DIGIT_PIN, MINUTES_SECOND_DIGIT_PIN};
+
+/**
+ * @brief Posuvný a výstupní registr SN74HC595
+ */
+static uint8_t shiftRegister = 0;
+static uint8_t latchRegister = 0;
+static bool lastSrclk = false;
+static bool lastRclk = false;
+
+/**
+ * @brief Co jednotlivé číslice naposledy ukazovaly, které právě svítí a od kdy
+ */
+static uint8_t shownSegments[NUMBER_OF_DIGITS];
+static uint8_t litDigits = 0;
+static uint64_t lastChange = 0;
+static uint64_t lastLit = 0;
+static PanelStats stats;
+static bool buzzerOn = false;
+static uint64_t buzzerSince = 0;
+static bool buzzerPinHigh = false;
+static uint64_t buzzerPinHighSince = 0;
+static uint64_t lastBuzzerHigh = 0;
+static bool logBuzzerChanges = false;
+
+static bool outputLevel(uint8_t pin) {
+    volatile uint8_t& port = pin < 8 ? PORTD : (pin < 14 ? PORTB : PORTC);
+    return port & (1 << (pin < 8 ? pin : (pin < 14 ? pin - 8 : pin - 14)));
+}
+
+void initPanelSim(bool logBuzzer) {
+    memset(&stats, 0, sizeof(stats));
+    memset(shownSegments, 0, sizeof(shownSegments));
+    logBuzzerChanges = logBuzzer;
+}
+
+/**
+ * @brief Program zapsal do některého registru PORTx, panel zpracuje hrany hodin registru a rozsvícení číslic
+ * Volá se z GpioPin (gpio/gpio.hpp) po každém zápisu v nativním buildu.
+ */
+void simPortWritten() {
+    uint64_t now = simMicros();
+    bool srclk = SrclkPin::port() & SrclkPin::mask;
+    bool rclk = RclkPin::port() & RclkPin::mask;
+    if (srclk && !lastSrclk) {
+        shiftRegister = (shiftRegister << 1) | ((SerPin::port() & SerPin::mask) ? 1 : 0);
+    }
+    if (rclk && !lastRclk) {
+        latchRegister = shiftRegister;
+    }
+    lastSrclk = srclk;
+    lastRclk = rclk;
+
+    uint8_t lit = 0;
+    for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
+        if (outputLevel(digitPins[i])) {
+            lit |= 1 << i;
+        }
+    }
+    if (now != lastChange) {
+        for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
+            if ((litDigits & (1 << i)) && shownSegments[i] != 0) {
+                stats.litMicros[i] += now - lastChange;
+            }
+        }
+        stats.windowMicros += now - lastChange;
+        lastChange = now;
+    }
+    litDigits = lit;
+    if (lit != 0) {
+        lastLit = now;
+    }
+    for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
+        if (lit & (1 << i)) {
+            shownSegments[i] = latchRegister;
+        }
+    }
+
+    // alarm bzučákem pípá a během pípnutí ho spíná podle hlasitosti, za zvonění se počítá, dokud se pin nepřestane spínat
+    bool buzzerPin = BuzzerPin::port() & BuzzerPin::mask;
+    if (buzzerPin && !buzzerPinHigh) {
+        buzzerPinHighSince = now;
+    } else if (!buzzerPin && buzzerPinHigh) {
+        stats.buzzerPinHighMicros += now - buzzerPinHighSince;
+    }
+    buzzerPinHigh = buzzerPin;
+    if (buzzerPin) {
+        lastBuzzerHigh = now;
+    }
+    bool buzzer = buzzerPin || (buzzerOn && now - lastBuzzerHigh < PANEL_SIM_BUZZER_SILENCE_MICROS);
+    if (buzzer != buzzerOn) {
+        if (buzzer) {
+            stats.buzzerOnCount++;
+        } else {
+            stats.buzzerOnMicros += lastBuzzerHigh - buzzerSince;
+        }
+        if (logBuzzerChanges) {
+            uint32_t seconds = ds3231SimSecondsOfDay();
+            printf("[day %u %02u:%02u:%02u] buzzer %s\n", (unsigned)ds3231SimDays(), (unsigned)(seconds / 3600),
+                   (unsigned)(seconds / 60 % 60), (unsigned)(seconds % 60), buzzer ? "on" : "off");
+        }
+        buzzerOn = buzzer;
+        buzzerSince = now;
+    }
+}
+
+/**
+ * @brief Přeloží segmenty číslice zpět na znak fontu, číslice mají přednost před písmeny se stejným tvarem
+ */
+static char decodeSegments(uint8_t segments) {
+    segments &= ~SEGMENT_DOT;
+    if (segments == 0) {
+        return ' ';
+    }
+    for (uint8_t number = 0; number < 10; number++) {
+        if (digitSegments(number) == segments) {
+            return '0' + number;
+        }
+    }
+    for (char character = FONT_FIRST_CHAR; character <= FONT_LAST_CHAR; character++) {
+        if (glyphSegments(character) == segments) {
+            return character;
+        }
+    }
+    return '?';
+}
+
+/**
+ * @brief Vrátí text, který panel naposledy ukazoval, NUMBER_OF_DIGITS znaků a ukončovací nula
+ */
+void panelSimText(char* text) {
+    for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
+        text[i] = decodeSegments(shownSegments[i]);
+    }
+    text[NUMBER_OF_DIGITS] = '\0';
+}
+
+uint8_t panelSimSegments(uint8_t digit) {
+    return shownSegments[digit];
+}
+
+bool panelSimDots() {
+    return DotsPin::port() & DotsPin::mask;
+}
+
+bool panelSimBuzzer() {
+    return buzzerOn;
+}
+
+/**
+ * @brief Čas, kdy naposledy svítila některá číslice, zhasnutý panel se nemá s časem porovnávat
+ */
+uint64_t panelSimLastLitMicros() {
+    return lastLit;
+}
+
+PanelStats panelSimStats() {
+    return stats;
+}
+
+void panelSimResetWindow() {
+    memset(stats.litMicros, 0, sizeof(stats.litMicros));
+    stats.windowMicros = 0;
+}
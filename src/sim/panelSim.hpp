@@ -0,0 +1,29 @@
+#ifndef __PANEL__SIM__HPP__
+#define __PANEL__SIM__HPP__
+#include <stdint.h>
+
+#include "display/display.hpp"
+
+/**
+ * Virtuální sedmisegmentový panel: model registru SN74HC595, číslicových pinů, dvojtečky a bzučáku.
+ * Stav se počítá z výstupních pinů, takže panel ukazuje přesně to, co by svítilo na desce.
+ */
+struct PanelStats {
+    uint64_t litMicros[NUMBER_OF_DIGITS];
+    uint64_t windowMicros;
+    uint32_t buzzerOnCount;
+    uint64_t buzzerOnMicros;
+    uint64_t buzzerPinHighMicros;
+};
+
+void initPanelSim(bool logBuzzer);
+void simPortWritten();
+void panelSimText(char* text);
+uint8_t panelSimSegments(uint8_t digit);
+bool panelSimDots();
+bool panelSimBuzzer();
+uint64_t panelSimLastLitMicros();
+PanelStats panelSimStats();
+void panelSimResetWindow();
+
+#endif
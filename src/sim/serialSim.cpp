@@ -0,0 +1,300 @@
+#include "sim/serialSim.hpp"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+
+#include "sim/ds3231Sim.hpp"
+#include "sim/sim.hpp"
+
+/**
+ * Bajt na lince má start bit, 8 datových bitů a stop bit, před voláním begin() se počítá s 9600 Bd
+ */
+#define SERIAL_SIM_BITS_PER_BYTE 10
+#define SERIAL_SIM_DEFAULT_BAUD 9600UL
+
+HardwareSerial Serial;
+
+/**
+ * @brief Bajt ze skriptu, který na linku dorazí nejdřív v daný čas
+ */
+struct QueuedByte {
+    uint64_t micros;
+    uint8_t data;
+};
+
+static QueuedByte queued[SERIAL_SIM_MAX_QUEUED];
+static size_t queuedLength = 0;
+static size_t queuedIndex = 0;
+
+/**
+ * @brief Přijímací kruhový buffer stejný jako v jádře Arduina, jedno místo zůstává volné
+ */
+static uint8_t rxBuffer[SERIAL_SIM_RX_BUFFER];
+static uint8_t rxHead = 0;
+static uint8_t rxTail = 0;
+static uint32_t overruns = 0;
+
+/**
+ * @brief Doba přenosu jednoho bajtu, čas, kdy je linka znovu volná pro příjem, a kdy se vyprázdní odesílací buffer
+ */
+static uint32_t byteMicros = SERIAL_SIM_BITS_PER_BYTE * 1000000UL / SERIAL_SIM_DEFAULT_BAUD;
+static bool started = false;
+static uint64_t rxFreeMicros = 0;
+static uint64_t txIdleMicros = 0;
+
+/**
+ * @brief Pseudoterminál, ze kterého se čtou přijímané bajty, a skutečný čas začátku simulace, podle kterého se simulace zpomalí
+ */
+static int ptyFd = -1;
+static uint64_t nextPollMicros = 0;
+static struct timespec wallStart;
+
+static void receiveByte(uint8_t data) {
+    if (!started) {
+        return;
+    }
+    uint8_t next = (rxHead + 1) % SERIAL_SIM_RX_BUFFER;
+    if (next == rxTail) {
+        overruns++;
+        return;
+    }
+    rxBuffer[rxHead] = data;
+    rxHead = next;
+}
+
+/**
+ * @brief Počká, až skutečný čas dožene virtuální, aby program na počítači komunikoval se simulací v reálném čase
+ */
+static void paceToWallClock(uint64_t now) {
+    struct timespec wall;
+    clock_gettime(CLOCK_MONOTONIC, &wall);
+    int64_t elapsed = (int64_t)(wall.tv_sec - wallStart.tv_sec) * 1000000 + (wall.tv_nsec - wallStart.tv_nsec) / 1000;
+    if ((int64_t)now > elapsed) {
+        usleep(now - elapsed);
+    }
+}
+
+static uint64_t serialNextEvent() {
+    uint64_t next = UINT64_MAX;
+    if (queuedIndex < queuedLength) {
+        next = queued[queuedIndex].micros > rxFreeMicros ? queued[queuedIndex].micros : rxFreeMicros;
+    }
+    if (ptyFd >= 0 && nextPollMicros < next) {
+        next = nextPollMicros;
+    }
+    return next;
+}
+
+static void serialFire(uint64_t now) {
+    if (queuedIndex < queuedLength && queued[queuedIndex].micros <= now && rxFreeMicros <= now) {
+        receiveByte(queued[queuedIndex++].data);
+        rxFreeMicros = now + byteMicros;
+    }
+    if (ptyFd >= 0 && nextPollMicros <= now) {
+        paceToWallClock(now);
+        uint8_t data;
+        if (read(ptyFd, &data, 1) == 1) {
+            receiveByte(data);
+        }
+        nextPollMicros = now + byteMicros;
+    }
+}
+
+void initSerialSim() {
+    simAddDevice({serialNextEvent, serialFire});
+}
+
+/**
+ * @brief Otevře pseudoterminál, na který se přesměruje výstup i vstup sériové linky, simulace pak běží v reálném čase
+ * 
+ * @return Cesta k pseudoterminálu pro program na počítači, NULL pokud ho nejde otevřít
+ */
+const char* serialSimOpenPty() {
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+        return NULL;
+    }
+    struct termios settings;
+    if (tcgetattr(fd, &settings) == 0) {
+        cfmakeraw(&settings);
+        tcsetattr(fd, TCSANOW, &settings);
+    }
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    ptyFd = fd;
+    clock_gettime(CLOCK_MONOTONIC, &wallStart);
+    return ptsname(fd);
+}
+
+/**
+ * @brief Zařadí bajty, které po sobě dorazí na linku od času micros, fronta musí zůstat seřazená podle času
+ */
+bool serialSimQueue(uint64_t micros, const uint8_t* data, size_t length) {
+    if (queuedLength + length > SERIAL_SIM_MAX_QUEUED ||
+        (queuedLength > 0 && queued[queuedLength - 1].micros > micros)) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        queued[queuedLength++] = {micros, data[i]};
+    }
+    return true;
+}
+
+uint32_t serialSimOverruns() {
+    return overruns;
+}
+
+/**
+ * @brief Kolik bajtů ještě čeká v odesílacím bufferu
+ */
+static uint32_t txQueuedBytes() {
+    uint64_t now = simMicros();
+    return txIdleMicros > now ? (txIdleMicros - now + byteMicros - 1) / byteMicros : 0;
+}
+
+/**
+ * @brief Zařadí bajt do odesílacího bufferu, plný buffer čeká jako na desce, než se místo uvolní
+ */
+static void transmitByte() {
+    while (txQueuedBytes() >= SERIAL_SIM_TX_BUFFER - 1) {
+        simAdvance(byteMicros);
+    }
+    uint64_t now = simMicros();
+    txIdleMicros = (txIdleMicros > now ? txIdleMicros : now) + byteMicros;
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    byteMicros = SERIAL_SIM_BITS_PER_BYTE * 1000000UL / baud;
+    started = true;
+}
+
+void HardwareSerial::end() {
+    started = false;
+}
+
+int HardwareSerial::available() {
+    return (SERIAL_SIM_RX_BUFFER + rxHead - rxTail) % SERIAL_SIM_RX_BUFFER;
+}
+
+int HardwareSerial::read() {
+    if (rxHead == rxTail) {
+        return -1;
+    }
+    uint8_t data = rxBuffer[rxTail];
+    rxTail = (rxTail + 1) % SERIAL_SIM_RX_BUFFER;
+    return data;
+}
+
+int HardwareSerial::peek() {
+    return rxHead == rxTail ? -1 : rxBuffer[rxTail];
+}
+
+int HardwareSerial::availableForWrite() {
+    return SERIAL_SIM_TX_BUFFER - 1 - txQueuedBytes();
+}
+
+void HardwareSerial::flush() {
+    simAdvance(txQueuedBytes() * byteMicros);
+    fflush(stdout);
+}
+
+/**
+ * @brief Jednotlivé bajty (text) jdou beze změny na standardní výstup nebo do pseudoterminálu
+ */
+size_t HardwareSerial::write(uint8_t data) {
+    transmitByte();
+    if (ptyFd >= 0) {
+        return ::write(ptyFd, &data, 1) == 1;
+    }
+    return fwrite(&data, 1, 1, stdout);
+}
+
+/**
+ * @brief Blok bajtů (rámec protokolu) se bez pseudoterminálu vypíše šestnáctkově na jeden řádek
+ */
+size_t HardwareSerial::write(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        transmitByte();
+    }
+    if (ptyFd >= 0) {
+        ssize_t written = ::write(ptyFd, data, length);
+        return written > 0 ? written : 0;
+    }
+    uint32_t seconds = ds3231SimSecondsOfDay();
+    printf("[day %u %02u:%02u:%02u] serial", (unsigned)ds3231SimDays(), (unsigned)(seconds / 3600),
+           (unsigned)(seconds / 60 % 60), (unsigned)(seconds % 60));
+    for (size_t i = 0; i < length; i++) {
+        printf(" %02X", data[i]);
+    }
+    printf("\n");
+    return length;
+}
+
+size_t HardwareSerial::print(const char* text) {
+    size_t length = 0;
+    while (text[length] != '\0') {
+        write((uint8_t)text[length++]);
+    }
+    return length;
+}
+
+size_t HardwareSerial::print(const __FlashStringHelper* text) {
+    return print(reinterpret_cast<const char*>(text));
+}
+
+size_t HardwareSerial::print(char character) {
+    return write((uint8_t)character);
+}
+
+size_t HardwareSerial::print(long value) {
+    char text[16];
+    snprintf(text, sizeof(text), "%ld", value);
+    return print(text);
+}
+
+size_t HardwareSerial::print(unsigned long value) {
+    char text[16];
+    snprintf(text, sizeof(text), "%lu", value);
+    return print(text);
+}
+
+size_t HardwareSerial::print(int value) {
+    return print((long)value);
+}
+
+size_t HardwareSerial::print(unsigned int value) {
+    return print((unsigned long)value);
+}
+
+size_t HardwareSerial::println(const char* text) {
+    return print(text) + println();
+}
+
+size_t HardwareSerial::println(const __FlashStringHelper* text) {
+    return print(text) + println();
+}
+
+size_t HardwareSerial::println(long value) {
+    return print(value) + println();
+}
+
+size_t HardwareSerial::println(unsigned long value) {
+    return print(value) + println();
+}
+
+size_t HardwareSerial::println(int value) {
+    return print(value) + println();
+}
+
+size_t HardwareSerial::println(unsigned int value) {
+    return print(value) + println();
+}
+
+size_t HardwareSerial::println() {
+    return print("\r\n");
+}
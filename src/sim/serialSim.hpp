@@ -0,0 +1,20 @@
+#ifndef __SERIAL__SIM__HPP__
+#define __SERIAL__SIM__HPP__
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Model sériové linky (HardwareSerial) simulátoru: přijímací kruhový buffer plněný rychlostí linky
+ * a odesílací buffer, který se vyprazdňuje stejnou rychlostí.
+ * Bajty přicházejí ze skriptu, nebo z pseudoterminálu, ke kterému se může připojit program na počítači.
+ */
+#define SERIAL_SIM_RX_BUFFER 64
+#define SERIAL_SIM_TX_BUFFER 64
+#define SERIAL_SIM_MAX_QUEUED 1024
+
+void initSerialSim();
+const char* serialSimOpenPty();
+bool serialSimQueue(uint64_t micros, const uint8_t* data, size_t length);
+uint32_t serialSimOverruns();
+
+#endif
@@ -0,0 +1,395 @@
+#include "sim/sim.hpp"
+
+#include <stdio.h>
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <avr/sleep.h>
+
+#include "gpio/gpio.hpp"
+
+#define SIM_MAX_DEVICES 8
+#define SIM_PENDING_TICK 0x01
+#define SIM_PENDING_PIN_CHANGE 0x02
+#define SIM_PENDING_COMPARE_B 0x04
+#define SIM_PENDING_TWI 0x08
+
+extern "C" void TIMER2_COMPA_vect(void);
+extern "C" void TIMER2_COMPB_vect(void);
+extern "C" void PCINT0_vect(void);
+extern "C" void TWI_vect(void);
+
+#define SIM_REGISTER(name) volatile uint8_t name;
+SIM_REGISTER(PINB)
+SIM_REGISTER(DDRB)
+SIM_REGISTER(PORTB)
+SIM_REGISTER(PINC)
+SIM_REGISTER(DDRC)
+SIM_REGISTER(PORTC)
+SIM_REGISTER(PIND)
+SIM_REGISTER(DDRD)
+SIM_REGISTER(PORTD)
+SIM_REGISTER(TCCR0A)
+SIM_REGISTER(TCCR0B)
+SIM_REGISTER(TIMSK0)
+SIM_REGISTER(TCCR1A)
+SIM_REGISTER(TCCR1B)
+SIM_REGISTER(TIMSK1)
+SIM_REGISTER(TIFR1)
+SIM_REGISTER(TCCR2A)
+SIM_REGISTER(TCCR2B)
+SIM_REGISTER(TCNT2)
+SIM_REGISTER(OCR2A)
+SIM_REGISTER(OCR2B)
+SIM_REGISTER(TIMSK2)
+SIM_REGISTER(TIFR2)
+SIM_REGISTER(ASSR)
+SIM_REGISTER(PCICR)
+SIM_REGISTER(PCIFR)
+SIM_REGISTER(PCMSK0)
+SIM_REGISTER(PCMSK1)
+SIM_REGISTER(PCMSK2)
+SIM_REGISTER(EICRA)
+SIM_REGISTER(EIMSK)
+SIM_REGISTER(SPCR)
+SIM_REGISTER(SPSR)
+SIM_REGISTER(SPDR)
+SIM_REGISTER(TWBR)
+SIM_REGISTER(TWSR)
+SIM_REGISTER(TWAR)
+SIM_REGISTER(TWDR)
+SIM_REGISTER(ADCSRA)
+SIM_REGISTER(ACSR)
+SIM_REGISTER(SMCR)
+SIM_REGISTER(MCUSR)
+SIM_REGISTER(PRR)
+SIM_REGISTER(SREG)
+#undef SIM_REGISTER
+volatile uint16_t TCNT1;
+volatile uint16_t OCR1A;
+
+EEPROMClass EEPROM;
+
+/**
+ * @brief Virtuální čas simulace v mikrosekundách a čas, kdy simulace končí
+ */
+uint64_t simNow = 0;
+uint64_t simEnd = UINT64_MAX;
+
+SimDevice simDevices[SIM_MAX_DEVICES];
+uint8_t simDeviceCount = 0;
+
+/**
+ * @brief Stav přerušení: globální povolení (bit I), právě běžící obsluha a přerušení čekající na povolení
+ */
+bool simInterruptsEnabled = false;
+bool simInInterrupt = false;
+uint8_t simPending = 0;
+
+/**
+ * @brief Čas příštího porovnání časovače 2, 0 pokud časovač neběží
+ */
+uint64_t simNextTick = 0;
+/**
+ * @brief Čas příštího porovnání B časovače 2 v aktuální periodě, 0 pokud v ní už žádné nebude
+ */
+uint64_t simNextCompareB = 0;
+uint32_t simTicks = 0;
+uint32_t simInterrupts = 0;
+uint32_t simWakes = 0;
+uint8_t simSleepMode = SLEEP_MODE_IDLE;
+
+uint8_t simEeprom[E2END + 1];
+bool simEepromErased = false;
+
+uint64_t simMicros() {
+    return simNow;
+}
+
+void simSetEndMicros(uint64_t end) {
+    simEnd = end;
+}
+
+void simAddDevice(SimDevice device) {
+    if (simDeviceCount < SIM_MAX_DEVICES) {
+        simDevices[simDeviceCount++] = device;
+    }
+}
+
+uint32_t simTickCount() {
+    return simTicks;
+}
+
+uint32_t simWakeCount() {
+    return simWakes;
+}
+
+/**
+ * @brief Perioda přerušení časovače 2 v mikrosekundách podle registrů TCCR2B a OCR2A
+ * 
+ * @return Perioda, 0 pokud časovač nebo jeho přerušení neběží
+ */
+uint32_t timer2PeriodMicros() {
+    static const uint16_t prescalers[] = {0, 1, 8, 32, 64, 128, 256, 1024};
+    uint16_t prescaler = prescalers[TCCR2B & 0x07];
+    if (prescaler == 0 || !(TIMSK2 & _BV(OCIE2A))) {
+        return 0;
+    }
+    return (uint32_t)(OCR2A + 1) * prescaler / (F_CPU / 1000000UL);
+}
+
+/**
+ * @brief Za kolik mikrosekund od začátku periody časovače 2 nastane porovnání B
+ * 
+ * @return Čas od začátku periody, 0 pokud přerušení COMPB není povolené nebo porovnání v periodě nenastane
+ */
+uint32_t timer2CompareBMicros() {
+    static const uint16_t prescalers[] = {0, 1, 8, 32, 64, 128, 256, 1024};
+    uint16_t prescaler = prescalers[TCCR2B & 0x07];
+    if (prescaler == 0 || !(TIMSK2 & _BV(OCIE2B)) || OCR2B >= OCR2A) {
+        return 0;
+    }
+    return (uint32_t)(OCR2B + 1) * prescaler / (F_CPU / 1000000UL);
+}
+
+/**
+ * @brief Volně běžící časovač 1 počítá od začátku simulace podle předděličky v TCCR1B
+ */
+void updateTimer1() {
+    static const uint16_t prescalers[] = {0, 1, 8, 64, 256, 1024, 0, 0};
+    uint16_t prescaler = prescalers[TCCR1B & 0x07];
+    if (prescaler != 0) {
+        TCNT1 = (uint16_t)(simNow * (F_CPU / 1000000UL) / prescaler);
+    }
+}
+
+/**
+ * @brief Zavolá obsluhu přerušení, pokud jsou přerušení povolená, jinak si ho zapamatuje na později
+ * 
+ * @param pending Které přerušení nastalo, 0 jen doručí dříve zapamatovaná přerušení
+ */
+void raiseInterrupt(uint8_t pending) {
+    simPending |= pending;
+    if (!simInterruptsEnabled || simInInterrupt) {
+        return;
+    }
+    while (simPending) {
+        // obsluha přerušení běží se zakázanými přerušeními, reti je zase povolí
+        simInInterrupt = true;
+        SREG &= ~_BV(SREG_I);
+        if (simPending & SIM_PENDING_TICK) {
+            simPending &= ~SIM_PENDING_TICK;
+            simTicks++;
+            TIMER2_COMPA_vect();
+        } else if (simPending & SIM_PENDING_COMPARE_B) {
+            simPending &= ~SIM_PENDING_COMPARE_B;
+            TIMER2_COMPB_vect();
+        } else if (simPending & SIM_PENDING_PIN_CHANGE) {
+            simPending &= ~SIM_PENDING_PIN_CHANGE;
+            PCINT0_vect();
+        } else if (simPending & SIM_PENDING_TWI) {
+            simPending &= ~SIM_PENDING_TWI;
+            TWI_vect();
+        }
+        simInInterrupt = false;
+        SREG |= _BV(SREG_I);
+        simInterruptsEnabled = true;
+        simInterrupts++;
+    }
+}
+
+/**
+ * @brief Posouvá virtuální čas po událostech až do času target a obsluhuje přerušení, která mezitím nastanou
+ * 
+ * @param target Čas, do kterého se simuluje
+ * @param stopOnWake True pokud se má skončit u prvního přerušení, které by probudilo spící procesor
+ */
+void runUntil(uint64_t target, bool stopOnWake) {
+    bool millisRunning = stopOnWake && simSleepMode == SLEEP_MODE_IDLE;
+    if (target < simNow) {
+        target = simNow;
+    }
+    uint32_t interruptsBefore = simInterrupts;
+    while (true) {
+        uint32_t tickPeriod = timer2PeriodMicros();
+        if (tickPeriod == 0) {
+            simNextTick = 0;
+        } else if (simNextTick == 0 || simNextTick <= simNow) {
+            simNextTick = simNow + tickPeriod;
+            simNextCompareB = 0;
+        }
+        uint64_t next = target;
+        if (simNextTick != 0 && simNextTick < next) {
+            next = simNextTick;
+        }
+        if (simNextCompareB != 0 && simNextCompareB < next) {
+            next = simNextCompareB;
+        }
+        if (millisRunning) {
+            // v idle běží i časovač 0 funkce millis(), který procesor budí každou milisekundu
+            uint64_t nextMillis = (simNow / 1000 + 1) * 1000;
+            if (nextMillis < next) {
+                next = nextMillis;
+            }
+        }
+        for (uint8_t i = 0; i < simDeviceCount; i++) {
+            uint64_t deviceNext = simDevices[i].nextEventMicros();
+            if (deviceNext < next) {
+                next = deviceNext < simNow ? simNow : deviceNext;
+            }
+        }
+        simNow = next;
+        updateTimer1();
+
+        for (uint8_t i = 0; i < simDeviceCount; i++) {
+            if (simDevices[i].nextEventMicros() <= simNow) {
+                simDevices[i].fire(simNow);
+            }
+        }
+        if (simNextCompareB != 0 && simNextCompareB <= simNow) {
+            simNextCompareB = 0;
+            raiseInterrupt(SIM_PENDING_COMPARE_B);
+        }
+        if (simNextTick != 0 && simNextTick <= simNow) {
+            uint32_t compareB = timer2CompareBMicros();
+            simNextCompareB = compareB != 0 ? simNextTick + compareB : 0;
+            simNextTick += tickPeriod;
+            raiseInterrupt(SIM_PENDING_TICK);
+        }
+        bool woken = simInterrupts != interruptsBefore || (millisRunning && simNow % 1000 == 0);
+        if ((stopOnWake && woken) || simNow >= target) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Posune virtuální čas, jako by procesor tolik času strávil výpočtem
+ * 
+ * @param micros Počet mikrosekund
+ */
+void simAdvance(uint32_t micros) {
+    runUntil(simNow + micros, false);
+}
+
+/**
+ * @brief Procesor usne, čas se posune k prvnímu přerušení, které ho probudí (nebo na konec simulace)
+ * V režimu power-down stojí časovače 0 i 2, probudit ho může jen změna pinu.
+ * 
+ */
+void simSleep() {
+    simWakes++;
+    // i po konci simulace procesor spí až do dalšího přerušení, jinak by čekání na sběrnici I2C nikdy neskončilo
+    runUntil(simNow < simEnd ? simEnd : UINT64_MAX, true);
+}
+
+/**
+ * @brief Nastaví úroveň vstupního pinu zvenku (tlačítko, pin INT) a vyvolá přerušení při změně pinu, pokud je povolené
+ * 
+ * @param pin Číslo pinu Arduina
+ * @param level Nová úroveň pinu
+ */
+void simSetInputPin(uint8_t pin, bool level) {
+    volatile uint8_t* input = pin < 8 ? &PIND : (pin < 14 ? &PINB : &PINC);
+    volatile uint8_t* pinChangeMask = pin < 8 ? &PCMSK2 : (pin < 14 ? &PCMSK0 : &PCMSK1);
+    uint8_t group = pin < 8 ? PCIE2 : (pin < 14 ? PCIE0 : PCIE1);
+    uint8_t mask = 1 << (pin < 8 ? pin : (pin < 14 ? pin - 8 : pin - 14));
+    bool current = *input & mask;
+    if (current == level) {
+        return;
+    }
+    *input = level ? *input | mask : *input & ~mask;
+    if ((*pinChangeMask & mask) && (PCICR & _BV(group))) {
+        raiseInterrupt(SIM_PENDING_PIN_CHANGE);
+    }
+}
+
+/**
+ * @brief Periferie TWI nastavila TWINT s povoleným přerušením
+ */
+void simRaiseTwiInterrupt() {
+    raiseInterrupt(SIM_PENDING_TWI);
+}
+
+void cli() {
+    simInterruptsEnabled = false;
+    SREG &= ~_BV(SREG_I);
+}
+
+void sei() {
+    simInterruptsEnabled = true;
+    SREG |= _BV(SREG_I);
+    if (simPending) {
+        raiseInterrupt(0);
+    }
+}
+
+void set_sleep_mode(uint8_t mode) {
+    simSleepMode = mode;
+}
+
+void sleep_cpu() {
+    simSleep();
+}
+
+unsigned long millis() {
+    return simNow / 1000;
+}
+
+unsigned long micros() {
+    return simNow;
+}
+
+void delay(unsigned long ms) {
+    simAdvance(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    simAdvance(us);
+}
+
+/**
+ * @brief Nová EEPROM je ze závodu vymazaná na 0xFF
+ */
+void eraseEepromOnce() {
+    if (!simEepromErased) {
+        memset(simEeprom, 0xFF, sizeof(simEeprom));
+        simEepromErased = true;
+    }
+}
+
+uint8_t EEPROMClass::read(int address) {
+    eraseEepromOnce();
+    return simEeprom[address & E2END];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    eraseEepromOnce();
+    simEeprom[address & E2END] = value;
+}
+
+void EEPROMClass::update(int address, uint8_t value) {
+    if (read(address) != value) {
+        write(address, value);
+    }
+}
+
+bool simLoadEeprom(const char* path) {
+    eraseEepromOnce();
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    size_t length = fread(simEeprom, 1, sizeof(simEeprom), file);
+    fclose(file);
+    return length == sizeof(simEeprom);
+}
+
+void simSaveEeprom(const char* path) {
+    eraseEepromOnce();
+    FILE* file = fopen(path, "wb");
+    if (file != NULL) {
+        fwrite(simEeprom, 1, sizeof(simEeprom), file);
+        fclose(file);
+    }
+}
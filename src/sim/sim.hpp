@@ -0,0 +1,36 @@
+#ifndef __SIM__HPP__
+#define __SIM__HPP__
+#include <stdint.h>
+
+/**
+ * Jádro simulátoru: virtuální čas v mikrosekundách, časovač 2, přerušení a externí zařízení.
+ * Program hodin běží nezměněný, simulátor jen místo hardwaru obsluhuje registry z <avr/io.h>.
+ */
+
+/**
+ * Virtuální čas, který stráví jeden průchod loop(), a čas přenosu jednoho bajtu po I2C při 100 kHz
+ */
+#define SIM_LOOP_MICROS 20
+#define SIM_I2C_BYTE_MICROS 90
+
+/**
+ * Externí zařízení simulátoru (čip reálného času, skript tlačítek), které chce v určitý čas něco udělat
+ */
+struct SimDevice {
+    uint64_t (*nextEventMicros)();
+    void (*fire)(uint64_t now);
+};
+
+uint64_t simMicros();
+void simSetEndMicros(uint64_t end);
+void simAddDevice(SimDevice device);
+void simAdvance(uint32_t micros);
+void simSleep();
+void simSetInputPin(uint8_t pin, bool level);
+void simRaiseTwiInterrupt();
+uint32_t simTickCount();
+uint32_t simWakeCount();
+void simSaveEeprom(const char* path);
+bool simLoadEeprom(const char* path);
+
+#endif
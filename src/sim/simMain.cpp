@@ -0,0 +1,591 @@
+/**
+ * Vstupní bod nativního buildu (pio run -e native): spustí nezměněný program hodin nad simulátorem.
+ *
+ * ./program [--days N] [--hours N] [--seconds N] [--start HH:MM:SS] [--script soubor] [--eeprom soubor] [--pty]
+ *           [--rtc-ppm N] [--rtc-temp N] [--replay soubor] [--verbose]
+ *
+ * Skript tlačítek má na každém řádku "<sekunda> press|release|click set|plus|minus|alarm|snooze",
+ * nebo "<sekunda> send <příkaz> <data...>" pro rámec protokolu sériové linky (délku a CRC doplní simulátor)
+ * a "<sekunda> sendraw <bajty...>" pro libovolné bajty, vše šestnáctkově. "<sekunda> rtc off|on" odpojí a připojí
+ * čip reálného času, "<sekunda> bus stuck" zasekne sběrnici I2C při příštím přenosu. "<sekunda> expect buzzer on|off"
+ * zkontroluje, zdali bzučák zrovna zní, nesplněné očekávání ukončí simulaci chybou. Řádky začínající # se přeskočí.
+ * Bez --start čip reálného času hlásí ztrátu napájení. S --pty simulace běží v reálném čase
+ * a sériová linka je na pseudoterminálu, jehož cestu vypíše na chybový výstup.
+ * --rtc-ppm zpomalí čip reálného času o N miliontin proti procesoru, aby šlo zkoušet odchylku času z ticku.
+ * --rtc-temp nastaví teplotu čidla čipu ve °C.
+ * --replay přehraje výpis záznamu událostí z desky (tools/clockctl.py trace): nastaví budík podle řádku config,
+ * čas podle prvního přečteného nebo nastaveného času, stiskne tlačítka v zaznamenaných časech a porovná
+ * přechody rozhraní a události buzení s výpisem. Bez --days, --hours a --seconds skončí chvíli po poslední události.
+ */
+#ifndef PIO_UNIT_TESTING
+// unit testy (pio test -e native) mají vlastní main a simulátor si obsluhují samy
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <Arduino.h>
+
+#include "buttons/buttonHandler.hpp"
+#include "crc/crc.hpp"
+#include "protocol/protocol.hpp"
+#include "sim/ds3231Sim.hpp"
+#include "sim/panelSim.hpp"
+#include "sim/serialSim.hpp"
+#include "sim/sim.hpp"
+#include "sim/twiSim.hpp"
+#include "trace/trace.hpp"
+#include "twi/twi.hpp"
+
+#ifdef SPI_PIN_LAYOUT
+#error "Simulator models the bit-banged display layout only"
+#endif
+
+#define SIM_MAX_SCRIPT_EVENTS 256
+#define SIM_CLICK_MICROS 100000ULL
+#define SIM_SECOND_MICROS 1000000ULL
+#define SIM_QUIET_MICROS (60 * SIM_SECOND_MICROS)
+#define SIM_SECONDS_IN_DAY 86400UL
+/**
+ * Události skriptu, které nejsou piny tlačítek: úroveň 1 čip připojí, 0 odpojí, závada sběrnice
+ * a očekávaný stav bzučáku
+ */
+#define SIM_SCRIPT_RTC 0xF0
+#define SIM_SCRIPT_BUS_STUCK 0xF1
+#define SIM_SCRIPT_EXPECT_BUZZER 0xF2
+/**
+ * Přehrání záznamu událostí: záznam začne po startu hodin, nastavení budíku se pošle ještě před ním
+ * a simulace skončí chvíli po poslední události, aby doběhly i přechody po uplynutí času
+ */
+#define SIM_MAX_REPLAY_RECORDS 256
+#define SIM_REPLAY_LEAD_MICROS (2 * SIM_SECOND_MICROS)
+#define SIM_REPLAY_CONFIG_MICROS (SIM_SECOND_MICROS / 2)
+#define SIM_REPLAY_TAIL_SECONDS 10
+#define SIM_REPLAY_TEXT_LENGTH 48
+
+void setup();
+void loop();
+
+/**
+ * @brief Událost skriptu tlačítek: v daný čas se pin tlačítka nastaví na danou úroveň (stisk je LOW)
+ */
+struct ScriptEvent {
+    uint64_t micros;
+    uint8_t pin;
+    bool level;
+};
+
+static ScriptEvent scriptEvents[SIM_MAX_SCRIPT_EVENTS];
+static uint16_t scriptLength = 0;
+static uint16_t scriptIndex = 0;
+static uint64_t lastScriptMicros = 0;
+static bool hadScriptEvent = false;
+static uint32_t expectations = 0;
+static uint32_t failedExpectations = 0;
+
+static const struct {
+    const char* name;
+    uint8_t pin;
+} buttonNames[] = {
+    {"set", TIME_SET_BUTTON},
+    {"plus", TIME_PLUS_BUTTON},
+    {"minus", TIME_MINUS_BUTTON},
+    {"alarm", ALERT_SET_BUTTON},
+    {"snooze", SNOOZE_BUTTON},
+};
+
+static uint64_t scriptNextEvent() {
+    return scriptIndex < scriptLength ? scriptEvents[scriptIndex].micros : UINT64_MAX;
+}
+
+static void scriptFire(uint64_t now) {
+    while (scriptIndex < scriptLength && scriptEvents[scriptIndex].micros <= now) {
+        const ScriptEvent& event = scriptEvents[scriptIndex++];
+        // závady sběrnice uživatel nevidí, kontrola displaye během nich běží dál
+        if (event.pin == SIM_SCRIPT_RTC) {
+            ds3231SimSetResponding(event.level);
+            continue;
+        }
+        if (event.pin == SIM_SCRIPT_BUS_STUCK) {
+            twiSimSetStuck();
+            continue;
+        }
+        if (event.pin == SIM_SCRIPT_EXPECT_BUZZER) {
+            expectations++;
+            if (panelSimBuzzer() != event.level) {
+                failedExpectations++;
+                uint32_t seconds = ds3231SimSecondsOfDay();
+                printf("[day %u %02u:%02u:%02u] expected buzzer %s\n", (unsigned)ds3231SimDays(),
+                       (unsigned)(seconds / 3600), (unsigned)(seconds / 60 % 60), (unsigned)(seconds % 60),
+                       event.level ? "on" : "off");
+            }
+            continue;
+        }
+        simSetInputPin(event.pin, event.level);
+        lastScriptMicros = now;
+        hadScriptEvent = true;
+    }
+}
+
+/**
+ * @brief Zařadí událost do skriptu tak, aby skript zůstal seřazený podle času
+ */
+static bool addScriptEvent(uint64_t micros, uint8_t pin, bool level) {
+    if (scriptLength >= SIM_MAX_SCRIPT_EVENTS) {
+        return false;
+    }
+    uint16_t i = scriptLength++;
+    while (i > 0 && scriptEvents[i - 1].micros > micros) {
+        scriptEvents[i] = scriptEvents[i - 1];
+        i--;
+    }
+    scriptEvents[i] = {micros, pin, level};
+    return true;
+}
+
+/**
+ * @brief Přečte šestnáctkové bajty ze zbytku řádku skriptu
+ * 
+ * @return Počet přečtených bajtů, -1 pokud řádek obsahuje něco jiného
+ */
+static int parseHexBytes(const char* text, uint8_t* data, int maxLength) {
+    int length = 0;
+    unsigned value;
+    int consumed;
+    while (sscanf(text, " %2x%n", &value, &consumed) == 1) {
+        if (length >= maxLength) {
+            return -1;
+        }
+        data[length++] = value;
+        text += consumed;
+    }
+    while (*text == ' ' || *text == '\t' || *text == '\r' || *text == '\n') {
+        text++;
+    }
+    return *text == '\0' ? length : -1;
+}
+
+/**
+ * @brief Zabalí příkaz a data do rámce protokolu a zařadí ho na sériovou linku
+ */
+static bool addSerialFrame(uint64_t micros, const uint8_t* data, int length) {
+    if (length < 1 || length - 1 > PROTOCOL_MAX_PAYLOAD) {
+        return false;
+    }
+    uint8_t frame[PROTOCOL_MAX_PAYLOAD + PROTOCOL_FRAME_OVERHEAD];
+    frame[0] = PROTOCOL_START_BYTE;
+    frame[1] = length - 1;
+    memcpy(&frame[2], data, length);
+    frame[length + 2] = crc8(&frame[1], length + 1);
+    return serialSimQueue(micros, frame, length + 3);
+}
+
+static bool loadScript(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open script %s\n", path);
+        return false;
+    }
+    char line[128];
+    unsigned lineNumber = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        lineNumber++;
+        double seconds;
+        char action[16];
+        int consumed;
+        if (line[0] == '#' || sscanf(line, "%lf %15s%n", &seconds, action, &consumed) != 2) {
+            continue;
+        }
+        uint64_t micros = (uint64_t)(seconds * SIM_SECOND_MICROS);
+        const char* rest = line + consumed;
+        bool added;
+        if (strcmp(action, "send") == 0 || strcmp(action, "sendraw") == 0) {
+            uint8_t data[sizeof(line) / 2];
+            int length = parseHexBytes(rest, data, sizeof(data));
+            if (strcmp(action, "send") == 0) {
+                added = addSerialFrame(micros, data, length);
+            } else {
+                added = length > 0 && serialSimQueue(micros, data, length);
+            }
+        } else if (strcmp(action, "rtc") == 0 || strcmp(action, "bus") == 0) {
+            char state[16];
+            added = sscanf(rest, "%15s", state) == 1;
+            if (added && strcmp(action, "rtc") == 0) {
+                added = (strcmp(state, "on") == 0 || strcmp(state, "off") == 0) &&
+                        addScriptEvent(micros, SIM_SCRIPT_RTC, strcmp(state, "on") == 0);
+            } else if (added) {
+                added = strcmp(state, "stuck") == 0 && addScriptEvent(micros, SIM_SCRIPT_BUS_STUCK, LOW);
+            }
+        } else if (strcmp(action, "expect") == 0) {
+            char device[16];
+            char state[16];
+            added = sscanf(rest, "%15s %15s", device, state) == 2 && strcmp(device, "buzzer") == 0 &&
+                    (strcmp(state, "on") == 0 || strcmp(state, "off") == 0) &&
+                    addScriptEvent(micros, SIM_SCRIPT_EXPECT_BUZZER, strcmp(state, "on") == 0);
+        } else {
+            char button[16];
+            int pin = -1;
+            if (sscanf(rest, "%15s", button) == 1) {
+                for (const auto& entry : buttonNames) {
+                    if (strcmp(entry.name, button) == 0) {
+                        pin = entry.pin;
+                    }
+                }
+            }
+            added = pin >= 0;
+            if (added && strcmp(action, "press") == 0) {
+                added = addScriptEvent(micros, pin, LOW);
+            } else if (added && strcmp(action, "release") == 0) {
+                added = addScriptEvent(micros, pin, HIGH);
+            } else if (added && strcmp(action, "click") == 0) {
+                added = addScriptEvent(micros, pin, LOW) && addScriptEvent(micros + SIM_CLICK_MICROS, pin, HIGH);
+            } else {
+                added = false;
+            }
+        }
+        if (!added) {
+            fprintf(stderr, "%s:%u: invalid or too many events\n", path, lineNumber);
+            fclose(file);
+            return false;
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Přechod rozhraní nebo událost buzení ze záznamu, porovnává se jako text bez času
+ */
+struct ReplayRecord {
+    uint64_t micros;
+    char text[SIM_REPLAY_TEXT_LENGTH];
+};
+
+static ReplayRecord expectedRecords[SIM_MAX_REPLAY_RECORDS];
+static uint16_t expectedLength = 0;
+static ReplayRecord replayedRecords[SIM_MAX_REPLAY_RECORDS];
+static uint16_t replayedLength = 0;
+static uint16_t replayedTraceCount = 0;
+
+static const char* const traceStates[] = {"clock",         "time-hours", "time-minutes", "alarm-hours",
+                                          "alarm-minutes", "snooze",     "temperature",  "alarm-status"};
+static const char* const traceEvents[] = {"set",          "plus",      "minus",      "alarm",      "snooze", "plus-repeat",
+                                          "minus-repeat", "plus-fast", "minus-fast", "long-press", "chord"};
+static const char* const traceAlarms[] = {"ring", "snooze", "off"};
+
+/**
+ * @brief Název ze seznamu, neznámý index se vypíše jako číslo
+ */
+template <size_t N>
+static const char* traceName(const char* const (&names)[N], uint8_t index, char* buffer) {
+    if (index < N) {
+        return names[index];
+    }
+    sprintf(buffer, "%u", index);
+    return buffer;
+}
+
+/**
+ * @brief Zapíše přechod rozhraní nebo událost buzení stejně jako tools/clockctl.py trace
+ *
+ * @return false Pokud jde o jiný druh záznamu
+ */
+static bool formatTraceRecord(const TraceRecord& record, char* text) {
+    char first[4], second[4], third[4];
+    const uint8_t* data = record.data;
+    if (record.type == TRACE_UI) {
+        const char* event = data[2] == TRACE_UI_TIMEOUT ? "timeout" : traceName(traceEvents, data[2], third);
+        snprintf(text, SIM_REPLAY_TEXT_LENGTH, "ui %s %s %s", traceName(traceStates, data[0], first),
+                 traceName(traceStates, data[1], second), event);
+        return true;
+    }
+    if (record.type == TRACE_ALARM) {
+        snprintf(text, SIM_REPLAY_TEXT_LENGTH, "alarm %s %u", traceName(traceAlarms, data[0], first), data[1]);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Převezme záznamy, které program zapsal od posledního volání, volá se po každém průchodu smyčkou
+ */
+static void collectReplayedRecords() {
+    for (; replayedTraceCount != getTraceCount(); replayedTraceCount++) {
+        TraceRecord record;
+        if (!getTraceRecord(replayedTraceCount, &record) || replayedLength >= SIM_MAX_REPLAY_RECORDS) {
+            continue;
+        }
+        if (formatTraceRecord(record, replayedRecords[replayedLength].text)) {
+            replayedRecords[replayedLength++].micros = simMicros();
+        }
+    }
+}
+
+/**
+ * @brief Načte výpis záznamu událostí, tlačítka zařadí do skriptu a přechody a buzení mezi očekávané záznamy
+ *
+ * @param end Kam se zapíše čas poslední události
+ * @param startSeconds Kam se zapíše čas čipu reálného času na začátku simulace, pokud ho záznam obsahuje
+ * @return false Pokud soubor nejde přečíst nebo obsahuje neznámý řádek
+ */
+static bool loadReplay(const char* path, uint64_t* end, int32_t* startSeconds) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open replay %s\n", path);
+        return false;
+    }
+    char line[128];
+    unsigned lineNumber = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        lineNumber++;
+        double seconds;
+        char kind[16], first[16], second[16], third[16];
+        unsigned hours, mins, secs, snooze;
+        bool added = false;
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        if (sscanf(line, "config %u:%u %15s %u", &hours, &mins, first, &snooze) == 4) {
+            uint8_t frame[] = {PROTOCOL_SET_CONFIG, (uint8_t)hours, (uint8_t)mins, strcmp(first, "on") == 0,
+                               (uint8_t)snooze};
+            added = addSerialFrame(SIM_REPLAY_CONFIG_MICROS, frame, sizeof(frame));
+        } else if (sscanf(line, "%lf %15s", &seconds, kind) == 2) {
+            uint64_t micros = SIM_REPLAY_LEAD_MICROS + (uint64_t)(seconds * SIM_SECOND_MICROS);
+            *end = micros;
+            int fields = sscanf(line, "%*f %*s %15s %15s %15s", first, second, third);
+            if (strcmp(kind, "button") == 0 && fields == 2) {
+                for (const auto& entry : buttonNames) {
+                    if (strcmp(entry.name, second) == 0) {
+                        // tlačítko se zaznamenalo až po debouncingu
+                        added = addScriptEvent(micros - DEBOUNCE_MILLIS * 1000ULL, entry.pin,
+                                               strcmp(first, "release") == 0);
+                    }
+                }
+            } else if ((strcmp(kind, "rtc") == 0 || strcmp(kind, "time-set") == 0) && fields == 1) {
+                added = sscanf(first, "%u:%u:%u", &hours, &mins, &secs) == 3;
+                if (added && *startSeconds < 0) {
+                    int32_t start = hours * 3600L + mins * 60L + secs -
+                                    (int32_t)((micros + SIM_SECOND_MICROS / 2) / SIM_SECOND_MICROS);
+                    *startSeconds = (start % (int32_t)SIM_SECONDS_IN_DAY + SIM_SECONDS_IN_DAY) % SIM_SECONDS_IN_DAY;
+                }
+            } else if ((strcmp(kind, "ui") == 0 && fields == 3) || (strcmp(kind, "alarm") == 0 && fields == 2)) {
+                added = expectedLength < SIM_MAX_REPLAY_RECORDS;
+                if (added) {
+                    ReplayRecord& record = expectedRecords[expectedLength++];
+                    record.micros = micros;
+                    snprintf(record.text, sizeof(record.text), fields == 3 ? "%s %s %s %s" : "%s %s %s", kind, first,
+                             second, third);
+                }
+            }
+        }
+        if (!added) {
+            fprintf(stderr, "%s:%u: invalid or too many records\n", path, lineNumber);
+            fclose(file);
+            return false;
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Porovná přechody rozhraní a události buzení z přehrání se záznamem
+ *
+ * @return true Pokud se shodují všechny
+ */
+static bool reportReplay() {
+    uint16_t matching = 0;
+    while (matching < expectedLength && matching < replayedLength &&
+           strcmp(expectedRecords[matching].text, replayedRecords[matching].text) == 0) {
+        matching++;
+    }
+    printf("replay:             %u of %u ui and alarm records match\n", matching, expectedLength);
+    if (matching == expectedLength && matching == replayedLength) {
+        return true;
+    }
+    if (matching < expectedLength) {
+        printf("  recorded at %.3f s: %s\n",
+               (double)(expectedRecords[matching].micros - SIM_REPLAY_LEAD_MICROS) / SIM_SECOND_MICROS,
+               expectedRecords[matching].text);
+    }
+    if (matching < replayedLength) {
+        printf("  replayed at %.3f s: %s\n",
+               ((double)replayedRecords[matching].micros - SIM_REPLAY_LEAD_MICROS) / SIM_SECOND_MICROS,
+               replayedRecords[matching].text);
+    }
+    return false;
+}
+
+static void printUsage(const char* program) {
+    fprintf(stderr,
+            "usage: %s [--days N] [--hours N] [--seconds N] [--start HH:MM:SS]\n"
+            "          [--script file] [--eeprom file] [--pty] [--rtc-ppm N] [--rtc-temp N] [--replay file]\n"
+            "          [--verbose]\n",
+            program);
+}
+
+int main(int argc, char** argv) {
+    double seconds = SIM_SECONDS_IN_DAY;
+    unsigned startHours = 0, startMins = 0, startSeconds = 0;
+    bool validTime = false;
+    const char* scriptPath = NULL;
+    const char* eepromPath = NULL;
+    bool verbose = false;
+    bool pty = false;
+    int32_t rtcPpm = 0;
+    double rtcTemperature = 22;
+    const char* replayPath = NULL;
+    bool hasLength = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--days") == 0 && hasValue) {
+            seconds = atof(argv[++i]) * SIM_SECONDS_IN_DAY;
+            hasLength = true;
+        } else if (strcmp(argv[i], "--hours") == 0 && hasValue) {
+            seconds = atof(argv[++i]) * 3600;
+            hasLength = true;
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            seconds = atof(argv[++i]);
+            hasLength = true;
+        } else if (strcmp(argv[i], "--start") == 0 && hasValue) {
+            validTime = sscanf(argv[++i], "%u:%u:%u", &startHours, &startMins, &startSeconds) == 3 &&
+                        startHours < 24 && startMins < 60 && startSeconds < 60;
+            if (!validTime) {
+                fprintf(stderr, "invalid start time %s\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--script") == 0 && hasValue) {
+            scriptPath = argv[++i];
+        } else if (strcmp(argv[i], "--eeprom") == 0 && hasValue) {
+            eepromPath = argv[++i];
+        } else if (strcmp(argv[i], "--rtc-ppm") == 0 && hasValue) {
+            rtcPpm = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--rtc-temp") == 0 && hasValue) {
+            rtcTemperature = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--replay") == 0 && hasValue) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            pty = true;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (scriptPath != NULL && !loadScript(scriptPath)) {
+        return 2;
+    }
+    if (replayPath != NULL) {
+        uint64_t replayEnd = 0;
+        int32_t replayStart = -1;
+        if (!loadReplay(replayPath, &replayEnd, &replayStart)) {
+            return 2;
+        }
+        if (!hasLength) {
+            seconds = (double)replayEnd / SIM_SECOND_MICROS + SIM_REPLAY_TAIL_SECONDS;
+        }
+        if (!validTime && replayStart >= 0) {
+            startHours = replayStart / 3600;
+            startMins = replayStart / 60 % 60;
+            startSeconds = replayStart % 60;
+            validTime = true;
+        }
+    }
+    if (eepromPath != NULL) {
+        simLoadEeprom(eepromPath);
+    }
+
+    uint64_t endMicros = (uint64_t)(seconds * SIM_SECOND_MICROS);
+    simSetEndMicros(endMicros);
+    initPanelSim(verbose);
+    initTwiSim();
+    initDs3231Sim(startHours, startMins, startSeconds, !validTime);
+    ds3231SimSetSlowdownPpm(rtcPpm);
+    ds3231SimSetTemperature(rtcTemperature);
+    for (const auto& entry : buttonNames) {
+        simSetInputPin(entry.pin, HIGH);
+    }
+    simAddDevice({scriptNextEvent, scriptFire});
+    initSerialSim();
+    if (pty) {
+        const char* ptyPath = serialSimOpenPty();
+        if (ptyPath == NULL) {
+            fprintf(stderr, "cannot open pseudo-terminal\n");
+            return 2;
+        }
+        fprintf(stderr, "serial port: %s\n", ptyPath);
+    }
+
+    clock_t wallStart = clock();
+    uint64_t loops = 0;
+    uint32_t checks = 0;
+    uint32_t mismatches = 0;
+    uint32_t lastCheckedMinute = UINT32_MAX;
+
+    setup();
+    while (simMicros() < endMicros) {
+        loop();
+        simAdvance(SIM_LOOP_MICROS);
+        loops++;
+        if (replayPath != NULL) {
+            collectReplayedRecords();
+        }
+
+        // dvě sekundy po změně minuty musí svítící panel ukazovat čas z čipu, pokud uživatel zrovna nic nenastavuje
+        uint32_t secondsOfDay = ds3231SimSecondsOfDay();
+        uint32_t minute = ds3231SimDays() * 1440 + secondsOfDay / 60;
+        bool quiet = !hadScriptEvent || simMicros() - lastScriptMicros >= SIM_QUIET_MICROS;
+        bool lit = simMicros() - panelSimLastLitMicros() < SIM_SECOND_MICROS;
+        if (secondsOfDay % 60 == 2 && minute != lastCheckedMinute && quiet && lit) {
+            lastCheckedMinute = minute;
+            char expected[16];
+            char shown[NUMBER_OF_DIGITS + 1];
+            snprintf(expected, sizeof(expected), "%2u%02u", (unsigned)(secondsOfDay / 3600),
+                     (unsigned)(secondsOfDay / 60 % 60));
+            panelSimText(shown);
+            checks++;
+            if (strcmp(expected, shown) != 0) {
+                mismatches++;
+                if (verbose) {
+                    printf("[day %u] display \"%s\" expected \"%s\"\n", (unsigned)ds3231SimDays(), shown, expected);
+                }
+            }
+        }
+    }
+    double wallSeconds = (double)(clock() - wallStart) / CLOCKS_PER_SEC;
+
+    if (eepromPath != NULL) {
+        simSaveEeprom(eepromPath);
+    }
+
+    PanelStats stats = panelSimStats();
+    double simulated = (double)simMicros() / SIM_SECOND_MICROS;
+    printf("simulated time:     %.0f s (%.2f days)\n", simulated, simulated / SIM_SECONDS_IN_DAY);
+    uint32_t finalSeconds = ds3231SimSecondsOfDay();
+    printf("final rtc time:     day %u %02u:%02u:%02u\n", (unsigned)ds3231SimDays(), (unsigned)(finalSeconds / 3600),
+           (unsigned)(finalSeconds / 60 % 60), (unsigned)(finalSeconds % 60));
+    printf("loop passes:        %llu\n", (unsigned long long)loops);
+    printf("tick interrupts:    %u\n", (unsigned)simTickCount());
+    printf("sleeps:             %u\n", (unsigned)simWakeCount());
+    printf("rtc transactions:   %u\n", (unsigned)ds3231SimTransactions());
+    printf("i2c bus hangs:      %u, recoveries %u\n", (unsigned)twiSimHangs(), (unsigned)getTwiRecoveries());
+    printf("buzzer activations: %u, sounding %.0f s, pin high %.1f s\n", (unsigned)stats.buzzerOnCount,
+           (double)stats.buzzerOnMicros / SIM_SECOND_MICROS, (double)stats.buzzerPinHighMicros / SIM_SECOND_MICROS);
+    printf("serial overruns:    %u\n", (unsigned)serialSimOverruns());
+    printf("display checks:     %u, mismatches %u\n", (unsigned)checks, (unsigned)mismatches);
+    if (expectations > 0) {
+        printf("expectations:       %u, failed %u\n", (unsigned)expectations, (unsigned)failedExpectations);
+    }
+    printf("digit duty cycle:  ");
+    for (uint8_t i = 0; i < NUMBER_OF_DIGITS; i++) {
+        printf(" %.1f%%", stats.windowMicros ? 100.0 * stats.litMicros[i] / stats.windowMicros : 0.0);
+    }
+    printf("\n");
+    printf("wall time:          %.2f s (%.0fx real time)\n", wallSeconds,
+           wallSeconds > 0 ? simulated / wallSeconds : 0.0);
+    bool replayed = replayPath == NULL || reportReplay();
+    return mismatches == 0 && failedExpectations == 0 && replayed ? 0 : 1;
+}
+
+#endif
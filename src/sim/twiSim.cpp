@@ -0,0 +1,167 @@
+#include "sim/twiSim.hpp"
+
+#include <Arduino.h>
+
+#include "sim/ds3231Sim.hpp"
+#include "sim/sim.hpp"
+#include "twi/twi.hpp"
+
+/**
+ * Stavové kódy, které periferie zapíše do TWSR
+ */
+#define TWI_SIM_START 0x08
+#define TWI_SIM_REPEATED_START 0x10
+#define TWI_SIM_WRITE_ADDRESS_ACK 0x18
+#define TWI_SIM_WRITE_ADDRESS_NACK 0x20
+#define TWI_SIM_WRITE_DATA_ACK 0x28
+#define TWI_SIM_WRITE_DATA_NACK 0x30
+#define TWI_SIM_READ_ADDRESS_ACK 0x40
+#define TWI_SIM_READ_ADDRESS_NACK 0x48
+#define TWI_SIM_READ_DATA_ACK 0x50
+#define TWI_SIM_READ_DATA_NACK 0x58
+
+/**
+ * Fáze přenosu: volná sběrnice, po podmínce START se posílá adresa, pak se zapisují nebo čtou data
+ */
+enum TwiSimPhase {
+    TWI_SIM_FREE,
+    TWI_SIM_ADDRESS,
+    TWI_SIM_WRITE,
+    TWI_SIM_READ
+};
+
+SimTwiControl TWCR;
+
+uint8_t twiSimPhase = TWI_SIM_FREE;
+bool twiSimSelected = false;
+
+/**
+ * @brief Čas, kdy doběhne rozpracovaná akce, a stav a data, které pak periferie nastaví
+ */
+uint64_t twiSimNextEventMicros = UINT64_MAX;
+uint8_t twiSimNextStatus;
+uint8_t twiSimNextData;
+
+/**
+ * @brief Závada připravená na příští START a zdali zařízení právě drží SDA v 0, takže žádná akce nedoběhne
+ */
+bool twiSimStuckArmed = false;
+bool twiSimHolding = false;
+uint32_t twiSimHangCount = 0;
+
+static void scheduleAction(uint8_t status, uint8_t data, uint32_t micros) {
+    twiSimNextStatus = status;
+    twiSimNextData = data;
+    twiSimNextEventMicros = simMicros() + micros;
+}
+
+/**
+ * @brief Zápis TWCR: 1 v TWINT smaže příznak a spustí akci podle TWSTA, TWSTO a fáze přenosu
+ */
+SimTwiControl& SimTwiControl::operator=(uint8_t control) {
+    if (!(control & _BV(TWEN))) {
+        // vypnutí periferie přenos přeruší, obnova sběrnice pulzy SCL uvolní zařízení, které drží SDA
+        value = control;
+        twiSimNextEventMicros = UINT64_MAX;
+        twiSimPhase = TWI_SIM_FREE;
+        if (twiSimHolding) {
+            twiSimHolding = false;
+            simSetInputPin(TWI_SDA_PIN, HIGH);
+        }
+        return *this;
+    }
+    if (!(control & _BV(TWINT))) {
+        value = (control & ~_BV(TWINT)) | (value & _BV(TWINT));
+        return *this;
+    }
+    value = control & ~(_BV(TWINT) | _BV(TWSTO));
+    if (control & _BV(TWSTO)) {
+        if (twiSimPhase != TWI_SIM_FREE && twiSimSelected) {
+            ds3231SimStop();
+        }
+        twiSimPhase = TWI_SIM_FREE;
+        twiSimSelected = false;
+        return *this;
+    }
+    if (twiSimHolding) {
+        return *this;
+    }
+    if (control & _BV(TWSTA)) {
+        if (twiSimStuckArmed) {
+            twiSimStuckArmed = false;
+            twiSimHolding = true;
+            twiSimHangCount++;
+            simSetInputPin(TWI_SDA_PIN, LOW);
+            return *this;
+        }
+        scheduleAction(twiSimPhase == TWI_SIM_FREE ? TWI_SIM_START : TWI_SIM_REPEATED_START, TWDR,
+                       TWI_SIM_CONDITION_MICROS);
+        twiSimPhase = TWI_SIM_ADDRESS;
+        return *this;
+    }
+    switch (twiSimPhase) {
+        case TWI_SIM_ADDRESS: {
+            bool read = TWDR & 0x01;
+            twiSimSelected = ds3231SimSelect(TWDR >> 1);
+            if (read) {
+                scheduleAction(twiSimSelected ? TWI_SIM_READ_ADDRESS_ACK : TWI_SIM_READ_ADDRESS_NACK, TWDR,
+                               SIM_I2C_BYTE_MICROS);
+            } else {
+                scheduleAction(twiSimSelected ? TWI_SIM_WRITE_ADDRESS_ACK : TWI_SIM_WRITE_ADDRESS_NACK, TWDR,
+                               SIM_I2C_BYTE_MICROS);
+            }
+            twiSimPhase = read ? TWI_SIM_READ : TWI_SIM_WRITE;
+            break;
+        }
+        case TWI_SIM_WRITE: {
+            bool ack = twiSimSelected && ds3231SimWrite(TWDR);
+            scheduleAction(ack ? TWI_SIM_WRITE_DATA_ACK : TWI_SIM_WRITE_DATA_NACK, TWDR, SIM_I2C_BYTE_MICROS);
+            break;
+        }
+        case TWI_SIM_READ: {
+            uint8_t data = twiSimSelected ? ds3231SimRead() : 0xFF;
+            scheduleAction(control & _BV(TWEA) ? TWI_SIM_READ_DATA_ACK : TWI_SIM_READ_DATA_NACK, data,
+                           SIM_I2C_BYTE_MICROS);
+            break;
+        }
+        default:
+            break;
+    }
+    return *this;
+}
+
+static uint64_t twiSimNextEvent() {
+    return twiSimNextEventMicros;
+}
+
+static void twiSimFire(uint64_t) {
+    twiSimNextEventMicros = UINT64_MAX;
+    TWSR = twiSimNextStatus;
+    TWDR = twiSimNextData;
+    TWCR.value |= _BV(TWINT);
+    if (TWCR.value & _BV(TWIE)) {
+        simRaiseTwiInterrupt();
+    }
+}
+
+/**
+ * @brief Zaregistruje periferii v simulátoru, linka SDA je v klidu v 1
+ */
+void initTwiSim() {
+    simSetInputPin(TWI_SDA_PIN, HIGH);
+    simAddDevice({twiSimNextEvent, twiSimFire});
+}
+
+/**
+ * @brief Při příští podmínce START zařízení zasekne sběrnici, uvolní ji až vypnutí periferie při obnově
+ */
+void twiSimSetStuck() {
+    twiSimStuckArmed = true;
+}
+
+/**
+ * @brief Kolikrát se sběrnice zasekla
+ */
+uint32_t twiSimHangs() {
+    return twiSimHangCount;
+}
@@ -0,0 +1,15 @@
+#ifndef __TWI__SIM__HPP__
+#define __TWI__SIM__HPP__
+#include <stdint.h>
+
+/**
+ * Model periferie TWI v režimu master: zápis do TWCR spustí akci, která po době přenosu na sběrnici
+ * nastaví TWSR, TWDR a příznak TWINT a vyvolá přerušení TWI. Jediné zařízení na sběrnici je model čipu DS3231.
+ */
+#define TWI_SIM_CONDITION_MICROS 10
+
+void initTwiSim();
+void twiSimSetStuck();
+uint32_t twiSimHangs();
+
+#endif
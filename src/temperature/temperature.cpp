@@ -0,0 +1,64 @@
+#include "temperature.hpp"
+
+#include <Arduino.h>
+
+#include "memory/memory.hpp"
+#include "time/rtc.hpp"
+
+/**
+ * @brief Poslední přečtená teplota ve čtvrtinách °C a zdali už se nějaká přečetla
+ */
+int16_t temperatureQuarters = 0;
+bool temperatureValid = false;
+
+/**
+ * @brief Zdali běží čtení teploty na pozadí a kdy se teplota naposledy přečetla
+ */
+bool temperatureRequested = false;
+unsigned long lastTemperatureMillis = 0;
+
+MEMORY_FOOTPRINT(temperature, sizeof(temperatureQuarters) + sizeof(temperatureValid) + sizeof(temperatureRequested) +
+                 sizeof(lastTemperatureMillis));
+
+/**
+ * @brief Vyzvedne dokončené čtení teploty a jednou za TEMPERATURE_REFRESH_MILLIS začne nové, na sběrnici nečeká
+ * Častější čtení by vracelo stále stejnou hodnotu, čip novou teplotu převede jen jednou za 64 sekund.
+ * Neúspěšné čtení se zopakuje při dalším volání.
+ * 
+ */
+void serviceTemperature() {
+    if (temperatureRequested) {
+        int16_t quarters;
+        uint8_t status = completeRtcTemperatureRequest(&quarters);
+        if (status == RTC_REQUEST_PENDING) {
+            return;
+        }
+        temperatureRequested = false;
+        if (status == RTC_REQUEST_DONE) {
+            temperatureQuarters = quarters;
+            temperatureValid = true;
+            lastTemperatureMillis = millis();
+        }
+        return;
+    }
+    if (temperatureValid && millis() - lastTemperatureMillis < TEMPERATURE_REFRESH_MILLIS) {
+        return;
+    }
+    temperatureRequested = requestRtcTemperatureRead();
+}
+
+/**
+ * @brief Zjistí, zdali už se teplota z čipu přečetla
+ */
+bool hasTemperature() {
+    return temperatureValid;
+}
+
+/**
+ * @brief Vrátí poslední přečtenou teplotu
+ * 
+ * @return Teplota ve čtvrtinách °C
+ */
+int16_t getTemperatureQuarters() {
+    return temperatureQuarters;
+}
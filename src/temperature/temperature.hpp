@@ -0,0 +1,17 @@
+#ifndef __TEMPERATURE__HPP__
+#define __TEMPERATURE__HPP__
+#include <Arduino.h>
+
+/**
+ * Teplota z čidla čipu DS3231. Čip ji sám převádí jen jednou za 64 sekund, proto se čte na pozadí
+ * jednou za TEMPERATURE_REFRESH_MILLIS a display ukazuje uloženou hodnotu bez komunikace s čipem.
+ */
+#ifndef TEMPERATURE_REFRESH_MILLIS
+#define TEMPERATURE_REFRESH_MILLIS 64000UL
+#endif
+
+void serviceTemperature();
+bool hasTemperature();
+int16_t getTemperatureQuarters();
+
+#endif
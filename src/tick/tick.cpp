@@ -0,0 +1,89 @@
+#include "tick.hpp"
+
+#include <Arduino.h>
+
+#include "buttons/buttonHandler.hpp"
+#include "buzzer/buzzer.hpp"
+#include "display/display.hpp"
+#include "memory/memory.hpp"
+#include "profiler/profiler.hpp"
+#include "time/time.hpp"
+
+/**
+ * @brief Hodnota OCR2B, při které přerušení zhasne display uprostřed slotu číslice, 0 pokud se nezhasíná
+ */
+uint8_t blankingCompare = 0;
+
+MEMORY_FOOTPRINT(tick, sizeof(blankingCompare));
+
+/**
+ * @brief Zapíše zhasínání displaye do časovače 2, přerušení COMPB je povolené jen při nastaveném zhasínání
+ */
+void applyBlanking() {
+    OCR2B = blankingCompare;
+    if (blankingCompare != 0) {
+        TIMSK2 |= _BV(OCIE2B);
+    } else {
+        TIMSK2 &= ~_BV(OCIE2B);
+    }
+}
+
+/**
+ * @brief Nastaví časovač 2 do režimu CTC tak, aby vyvolal přerušení TICK_FREQUENCY krát za sekundu
+ * 
+ */
+void initTick() {
+    noInterrupts();
+    TCCR2A = _BV(WGM21);              // CTC, TOP = OCR2A
+    TCCR2B = _BV(CS22) | _BV(CS20);   // předdělička 128
+    TCNT2 = 0;
+    OCR2A = TICK_TIMER_COMPARE;
+    TIMSK2 = _BV(OCIE2A);
+    applyBlanking();
+    profileTickStarted();
+    interrupts();
+}
+
+/**
+ * @brief Zastaví časovač 2 i přerušení ticku, např. před úsporným režimem
+ * 
+ */
+void stopTick() {
+    TIMSK2 = 0;
+    TCCR2B = 0;
+}
+
+/**
+ * @brief Nastaví, v kterém kroku časovače 2 se má rozsvícená číslice zhasnout, nastavení přežije i stopTick
+ * 
+ * @param compare Krok časovače od 1 do TICK_TIMER_COMPARE, 0 pokud má číslice svítit celý slot
+ */
+void setTickBlanking(uint8_t compare) {
+    noInterrupts();
+    blankingCompare = compare;
+    if (TIMSK2 & _BV(OCIE2A)) {
+        applyBlanking();
+    }
+    interrupts();
+}
+
+/**
+ * @brief Přerušení ticku, obnoví jednu číslici displaye, posune debouncing tlačítek, počítání sekund a vzor bzučáku
+ * 
+ */
+ISR(TIMER2_COMPA_vect) {
+    profileTickEntered();
+    PROFILE_SCOPE(PROFILE_TICK);
+    refreshDisplay();
+    buttonsTick();
+    timeTick();
+    buzzerTick();
+}
+
+/**
+ * @brief Přerušení uprostřed slotu číslice, zhasne display a tím sníží jeho jas
+ * 
+ */
+ISR(TIMER2_COMPB_vect) {
+    blankDisplay();
+}
@@ -0,0 +1,22 @@
+#ifndef __TICK__HPP__
+#define __TICK__HPP__
+#include <Arduino.h>
+
+#include "display/display.hpp"
+
+/**
+ * Tick je přerušení časovače 2, které obnovuje jednu číslici displaye a obsluhuje debouncing tlačítek.
+ * Jeho frekvence je proto daná obnovovací frekvencí displaye.
+ */
+#define TICK_FREQUENCY (REFRESH_RATE * NUMBER_OF_DIGITS)
+#define TICK_TIMER_PRESCALER 128
+#define TICK_TIMER_COMPARE (F_CPU / TICK_TIMER_PRESCALER / TICK_FREQUENCY - 1)
+#define MILLIS_TO_TICKS(millis) ((uint32_t)(millis) * TICK_FREQUENCY / 1000)
+
+static_assert(TICK_TIMER_COMPARE > 0 && TICK_TIMER_COMPARE <= 255, "REFRESH_RATE is out of range of timer 2");
+
+void initTick();
+void stopTick();
+void setTickBlanking(uint8_t compare);
+
+#endif
@@ -0,0 +1,362 @@
+#include "rtc.hpp"
+
+#include <Arduino.h>
+
+#include "gpio/gpio.hpp"
+#include "memory/memory.hpp"
+#include "profiler/profiler.hpp"
+#include "twi/twi.hpp"
+
+typedef GpioPin<RTC_INT_PIN> RtcIntPin;
+
+/**
+ * @brief Logická hodnota, zdali čip stáhl pin INT do 0 a hlavní smyčka to ještě nezpracovala
+ */
+volatile bool rtcInterruptPending = false;
+
+/**
+ * @brief Registry času, které do bufferu zapíše obsluha přerušení TWI, a stav rozpracovaného přenosu času
+ */
+volatile uint8_t rtcTimeSnapshot[DS3231_TIME_REGISTERS];
+volatile uint8_t rtcTimeRequestStatus = TWI_IDLE;
+
+/**
+ * @brief Registry teploty a stav jejich čtení na pozadí
+ */
+volatile uint8_t rtcTemperatureSnapshot[DS3231_TEMPERATURE_REGISTERS];
+volatile uint8_t rtcTemperatureRequestStatus = TWI_IDLE;
+
+/**
+ * @brief Stav zápisu alarmů na pozadí, stavový registr a stav jeho čtení na pozadí
+ */
+volatile uint8_t rtcAlarmRequestStatus = TWI_IDLE;
+volatile uint8_t rtcStatusSnapshot;
+volatile uint8_t rtcFlagsRequestStatus = TWI_IDLE;
+
+/**
+ * @brief Kontrolní registr čipu, čip ho sám nemění, a tak se zapisuje z této kopie bez předchozího čtení
+ * EOSC = 0, oscilátor běží i z baterie, INTCN = 1, pin INT ohlašuje alarmy.
+ */
+uint8_t rtcControl = DS3231_INTCN;
+
+MEMORY_FOOTPRINT(rtc, sizeof(rtcInterruptPending) + sizeof(rtcTimeSnapshot) + sizeof(rtcTimeRequestStatus) +
+                 sizeof(rtcTemperatureSnapshot) + sizeof(rtcTemperatureRequestStatus) + sizeof(rtcAlarmRequestStatus) +
+                 sizeof(rtcStatusSnapshot) + sizeof(rtcFlagsRequestStatus) + sizeof(rtcControl));
+
+/**
+ * @brief Spustí sběrnici I2C, na které je čip reálného času
+ * 
+ */
+void initRtc() {
+    initTwi();
+    RtcIntPin::setInputPullup();
+    RtcIntPin::enablePinChangeInterrupt();
+}
+
+/**
+ * @brief Přečte jedním přenosem několik po sobě jdoucích registrů čipu DS3231 a počká na jeho konec
+ * Čip si hodnoty registrů zkopíruje při začátku přenosu, takže se čtené hodnoty nemohou během čtení změnit.
+ * Rozpracovaný přenos času se nejdřív nechá doběhnout, čekání je tak nejvýše dvakrát TWI_TIMEOUT_MILLIS.
+ * 
+ * @param firstRegister Adresa prvního registru
+ * @param data Pole, kam se registry uloží
+ * @param length Počet registrů
+ * @return true Pokud přenos proběhl celý
+ * @return false Pokud čip neodpověděl, data pak nejsou platná
+ */
+bool readRtcRegisters(uint8_t firstRegister, uint8_t* data, uint8_t length) {
+    PROFILE_SCOPE(PROFILE_RTC_READ);
+    volatile uint8_t status;
+    waitForTwi();
+    if (!startTwiRead(DS3231_ADDRESS, firstRegister, data, length, &status)) {
+        return false;
+    }
+    waitForTwi();
+    return status == TWI_DONE;
+}
+
+/**
+ * @brief Zapíše jedním přenosem několik po sobě jdoucích registrů čipu DS3231 a počká na jeho konec
+ * 
+ * @param firstRegister Adresa prvního registru
+ * @param data Hodnoty registrů
+ * @param length Počet registrů
+ * @return true Pokud čip zápis potvrdil
+ * @return false Pokud čip neodpověděl
+ */
+bool writeRtcRegisters(uint8_t firstRegister, const uint8_t* data, uint8_t length) {
+    volatile uint8_t status;
+    waitForTwi();
+    if (!startTwiWrite(DS3231_ADDRESS, firstRegister, data, length, &status)) {
+        return false;
+    }
+    waitForTwi();
+    return status == TWI_DONE;
+}
+
+/**
+ * @brief Začne na pozadí čtení registrů času do bufferu, výsledek se vyzvedne přes completeRtcTimeRequest
+ * 
+ * @return false Pokud sběrnice zrovna přenáší něco jiného nebo předchozí přenos času nebyl vyzvednutý
+ */
+bool requestRtcTimeRead() {
+    if (rtcTimeRequestStatus != TWI_IDLE) {
+        return false;
+    }
+    return startTwiRead(DS3231_ADDRESS, DS3231_SECONDS_REGISTER, rtcTimeSnapshot, DS3231_TIME_REGISTERS,
+                        &rtcTimeRequestStatus);
+}
+
+/**
+ * @brief Začne na pozadí zápis registrů času, výsledek se vyzvedne přes completeRtcTimeRequest
+ * 
+ * @param registers Sekundy, minuty a hodiny v BCD, zkopírují se
+ * @return false Pokud sběrnice zrovna přenáší něco jiného nebo předchozí přenos času nebyl vyzvednutý
+ */
+bool requestRtcTimeWrite(const uint8_t* registers) {
+    if (rtcTimeRequestStatus != TWI_IDLE) {
+        return false;
+    }
+    return startTwiWrite(DS3231_ADDRESS, DS3231_SECONDS_REGISTER, registers, DS3231_TIME_REGISTERS,
+                         &rtcTimeRequestStatus);
+}
+
+/**
+ * @brief Zjistí, jak dopadl přenos spuštěný na pozadí, dokončený přenos vyzvedne
+ * Nikdy nečeká, přenos, který běží déle než TWI_TIMEOUT_MILLIS, se zruší a skončí jako neúspěšný.
+ * 
+ * @param requestStatus Stav přenosu, který zapisuje ovladač TWI
+ * @return RTC_REQUEST_PENDING dokud přenos běží, jinak RTC_REQUEST_DONE nebo RTC_REQUEST_FAILED
+ */
+uint8_t completeRequest(volatile uint8_t* requestStatus) {
+    isTwiBusy();
+    uint8_t status = *requestStatus;
+    if (status == TWI_BUSY) {
+        return RTC_REQUEST_PENDING;
+    }
+    *requestStatus = TWI_IDLE;
+    return status == TWI_DONE ? RTC_REQUEST_DONE : RTC_REQUEST_FAILED;
+}
+
+/**
+ * @brief Zjistí, jak dopadl přenos času spuštěný na pozadí, dokončený přenos vyzvedne
+ * 
+ * @param registers Kam se po dokončeném čtení zkopírují sekundy, minuty a hodiny v BCD, může být nullptr
+ * @return RTC_REQUEST_PENDING dokud přenos běží, jinak RTC_REQUEST_DONE nebo RTC_REQUEST_FAILED
+ */
+uint8_t completeRtcTimeRequest(uint8_t* registers) {
+    uint8_t status = completeRequest(&rtcTimeRequestStatus);
+    if (status == RTC_REQUEST_DONE && registers != nullptr) {
+        for (uint8_t i = 0; i < DS3231_TIME_REGISTERS; i++) {
+            registers[i] = rtcTimeSnapshot[i];
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Začne na pozadí čtení teploty, výsledek se vyzvedne přes completeRtcTemperatureRequest
+ * 
+ * @return false Pokud sběrnice zrovna přenáší něco jiného nebo předchozí čtení teploty nebylo vyzvednuté
+ */
+bool requestRtcTemperatureRead() {
+    if (rtcTemperatureRequestStatus != TWI_IDLE) {
+        return false;
+    }
+    return startTwiRead(DS3231_ADDRESS, DS3231_TEMPERATURE_REGISTER, rtcTemperatureSnapshot,
+                        DS3231_TEMPERATURE_REGISTERS, &rtcTemperatureRequestStatus);
+}
+
+/**
+ * @brief Zjistí, jak dopadlo čtení teploty spuštěné na pozadí, dokončené čtení vyzvedne
+ * 
+ * @param quarterDegrees Kam se po dokončeném čtení uloží teplota ve čtvrtinách °C
+ * @return RTC_REQUEST_PENDING dokud přenos běží, jinak RTC_REQUEST_DONE nebo RTC_REQUEST_FAILED
+ */
+uint8_t completeRtcTemperatureRequest(int16_t* quarterDegrees) {
+    uint8_t status = completeRequest(&rtcTemperatureRequestStatus);
+    if (status == RTC_REQUEST_DONE) {
+        *quarterDegrees = (int8_t)rtcTemperatureSnapshot[0] * 4 + (rtcTemperatureSnapshot[1] >> 6);
+    }
+    return status;
+}
+
+/**
+ * @brief Začne na pozadí zápis alarmu 1 čipu DS3231 tak, aby každý den v zadaný čas stáhl pin INT do 0
+ * Jedním přenosem se zapíší oba alarmy, kontrolní i stavový registr. Případný starý příznak A1F se smaže,
+ * aby alarm nezazvonil hned po zapnutí, zápis 1 příznaky OSF a A2F nezmění.
+ * Výsledek se vyzvedne přes completeRtcAlarmRequest.
+ * 
+ * @param hours Hodina alarmu
+ * @param mins Minuta alarmu
+ * @param seconds Sekunda alarmu
+ * @param enabled True pokud má alarm budit
+ * @return false Pokud sběrnice zrovna přenáší něco jiného nebo předchozí zápis alarmu nebyl vyzvednutý
+ */
+bool requestRtcAlarmWrite(uint8_t hours, uint8_t mins, uint8_t seconds, bool enabled) {
+    if (rtcAlarmRequestStatus != TWI_IDLE) {
+        return false;
+    }
+    uint8_t control = enabled ? rtcControl | DS3231_A1IE : rtcControl & ~DS3231_A1IE;
+    // A1M1 až A1M3 nulové a A1M4 nastavený znamenají shodu sekund, minut a hodin každý den,
+    // A2M2 až A2M4 nastavené znamenají shodu alarmu 2 na začátku každé minuty (setRtcMinuteInterrupt)
+    uint8_t registers[DS3231_ALARM_REGISTERS] = {
+        binaryToBcd(seconds), binaryToBcd(mins), binaryToBcd(hours), DS3231_ALARM_MASK_BIT,
+        DS3231_ALARM_MASK_BIT, DS3231_ALARM_MASK_BIT, DS3231_ALARM_MASK_BIT,
+        control, DS3231_OSF | DS3231_EN32KHZ | DS3231_A2F};
+    if (!startTwiWrite(DS3231_ADDRESS, DS3231_ALARM1_SECONDS_REGISTER, registers, DS3231_ALARM_REGISTERS,
+                       &rtcAlarmRequestStatus)) {
+        return false;
+    }
+    rtcControl = control;
+    return true;
+}
+
+/**
+ * @brief Zjistí, jak dopadl zápis alarmu spuštěný na pozadí, dokončený zápis vyzvedne
+ * 
+ * @return RTC_REQUEST_PENDING dokud přenos běží, jinak RTC_REQUEST_DONE nebo RTC_REQUEST_FAILED
+ */
+uint8_t completeRtcAlarmRequest() {
+    return completeRequest(&rtcAlarmRequestStatus);
+}
+
+/**
+ * @brief Začne na pozadí čtení příznaků stavového registru, výsledek se vyzvedne přes completeRtcFlagsRequest
+ * 
+ * @return false Pokud sběrnice zrovna přenáší něco jiného nebo předchozí čtení příznaků nebylo vyzvednuté
+ */
+bool requestRtcFlagsRead() {
+    if (rtcFlagsRequestStatus != TWI_IDLE) {
+        return false;
+    }
+    return startTwiRead(DS3231_ADDRESS, DS3231_STATUS_REGISTER, &rtcStatusSnapshot, 1, &rtcFlagsRequestStatus);
+}
+
+/**
+ * @brief Zjistí, jak dopadlo čtení příznaků spuštěné na pozadí, dokončené čtení vyzvedne
+ * 
+ * @param flags Kam se po dokončeném čtení uloží nastavené příznaky OSF, A2F a A1F
+ * @return RTC_REQUEST_PENDING dokud přenos běží, jinak RTC_REQUEST_DONE nebo RTC_REQUEST_FAILED
+ */
+uint8_t completeRtcFlagsRequest(uint8_t* flags) {
+    uint8_t status = completeRequest(&rtcFlagsRequestStatus);
+    if (status == RTC_REQUEST_DONE) {
+        *flags = rtcStatusSnapshot & DS3231_FLAGS;
+    }
+    return status;
+}
+
+/**
+ * @brief Zjistí z příznaku OSF, zdali se oscilátor čipu někdy zastavil, tedy jestli čip ztratil napájení i z baterie
+ * 
+ * @return true Pokud čas v čipu není platný, nebo čip neodpovídá
+ */
+bool hasRtcLostPower() {
+    uint8_t status;
+    if (!readRtcRegisters(DS3231_STATUS_REGISTER, &status, 1)) {
+        return true;
+    }
+    return status & DS3231_OSF;
+}
+
+/**
+ * @brief Smaže příznak OSF a zajistí, že oscilátor poběží i z baterie (EOSC = 0)
+ * 
+ */
+void clearRtcLostPower() {
+    writeRtcRegisters(DS3231_CONTROL_REGISTER, &rtcControl, 1);
+    clearRtcFlags(DS3231_OSF);
+}
+
+/**
+ * @brief Smaže vybrané příznaky stavového registru
+ * Zápis 1 příznak nezmění, ostatní příznaky se proto zapisují jako 1, aby se nesmazal příznak,
+ * který čip nastavil mezi čtením a zápisem registru.
+ * 
+ * @param flags Příznaky, které se mají smazat
+ * @return true Pokud čip zápis potvrdil
+ */
+bool clearRtcFlags(uint8_t flags) {
+    uint8_t status;
+    if (!readRtcRegisters(DS3231_STATUS_REGISTER, &status, 1)) {
+        return false;
+    }
+    status = (status | DS3231_FLAGS) & ~flags;
+    return writeRtcRegisters(DS3231_STATUS_REGISTER, &status, 1);
+}
+
+/**
+ * @brief Zapne nebo vypne alarm 2 čipu DS3231 tak, aby na začátku každé minuty stáhl pin INT do 0
+ * Při vypnutí se zároveň smaže příznak alarmu 2, takže pin INT se uvolní.
+ * Na sběrnici čeká, volá se jen při uspání do režimu power-down a po probuzení.
+ * 
+ * @param enabled True pokud se má čip budit každou minutu
+ */
+void setRtcMinuteInterrupt(bool enabled) {
+    if (enabled) {
+        // A2M2, A2M3 i A2M4 nastavené znamenají shodu jen v sekundě 00 každé minuty
+        uint8_t alarm[DS3231_ALARM2_REGISTERS] = {DS3231_ALARM_MASK_BIT, DS3231_ALARM_MASK_BIT, DS3231_ALARM_MASK_BIT};
+        writeRtcRegisters(DS3231_ALARM2_MINUTES_REGISTER, alarm, DS3231_ALARM2_REGISTERS);
+    }
+    rtcControl = enabled ? rtcControl | DS3231_A2IE : rtcControl & ~DS3231_A2IE;
+    writeRtcRegisters(DS3231_CONTROL_REGISTER, &rtcControl, 1);
+    clearRtcFlags(DS3231_A2F);
+}
+
+/**
+ * @brief Zjistí, zdali čip DS3231 právě drží pin INT v 0
+ * 
+ * @return true Pokud má čip aktivní přerušení
+ */
+bool isRtcInterruptActive() {
+    return !RtcIntPin::read();
+}
+
+/**
+ * @brief Volá se z přerušení při změně pinu, sestupná hrana pinu INT znamená nový alarm čipu
+ * 
+ */
+void rtcPinChanged() {
+    if (!RtcIntPin::read()) {
+        rtcInterruptPending = true;
+    }
+}
+
+/**
+ * @brief Zjistí a smaže, zdali od posledního volání čip vyvolal přerušení
+ * 
+ * @return true Pokud čip stáhl pin INT do 0
+ */
+bool takeRtcInterrupt() {
+    noInterrupts();
+    bool pending = rtcInterruptPending;
+    rtcInterruptPending = false;
+    interrupts();
+    return pending;
+}
+
+/**
+ * @brief Převede hodnotu v BCD na binární číslo, bez dělení
+ * 
+ * @param bcd Hodnota v BCD, desítky v horním nibblu
+ * @return Binární hodnota
+ */
+uint8_t bcdToBinary(uint8_t bcd) {
+    return (bcd >> 4) * 10 + (bcd & 0x0F);
+}
+
+/**
+ * @brief Převede binární číslo od 0 do 99 na BCD, bez dělení
+ * 
+ * @param value Binární hodnota
+ * @return Hodnota v BCD
+ */
+uint8_t binaryToBcd(uint8_t value) {
+    uint8_t tens = 0;
+    while (value >= 10) {
+        value -= 10;
+        tens++;
+    }
+    return (tens << 4) | value;
+}
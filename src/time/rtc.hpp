@@ -0,0 +1,86 @@
+#ifndef __RTC__HPP__
+#define __RTC__HPP__
+#include <Arduino.h>
+
+#define DS3231_ADDRESS 0x68
+/**
+ * Registry čipu DS3231, sekundy, minuty a hodiny leží za sebou a čtou se jedním přenosem
+ */
+#define DS3231_SECONDS_REGISTER 0x00
+#define DS3231_MINUTES_REGISTER 0x01
+#define DS3231_HOURS_REGISTER 0x02
+#define DS3231_TIME_REGISTERS 3
+#define DS3231_HOURS_MASK 0x3F  // bit 6 = 0 znamená 24 hodinový mód
+#define DS3231_12_HOUR_MODE 0x40
+#define DS3231_PM 0x20           // ve 12 hodinovém módu odpoledne
+#define DS3231_12_HOURS_MASK 0x1F
+#define DS3231_ALARM1_SECONDS_REGISTER 0x07
+#define DS3231_ALARM1_REGISTERS 4
+#define DS3231_ALARM2_MINUTES_REGISTER 0x0B
+#define DS3231_ALARM2_REGISTERS 3
+#define DS3231_ALARM_MASK_BIT 0x80
+#define DS3231_CONTROL_REGISTER 0x0E
+#define DS3231_STATUS_REGISTER 0x0F
+/**
+ * Alarm 1, alarm 2, kontrolní a stavový registr leží za sebou a zapisují se jedním přenosem
+ */
+#define DS3231_ALARM_REGISTERS 9
+/**
+ * Teplota se znaménkem, celé stupně v prvním registru a čtvrtstupně v horních dvou bitech druhého
+ */
+#define DS3231_TEMPERATURE_REGISTER 0x11
+#define DS3231_TEMPERATURE_REGISTERS 2
+/**
+ * Bity kontrolního a stavového registru
+ */
+#define DS3231_EOSC 0x80
+#define DS3231_INTCN 0x04
+#define DS3231_A2IE 0x02
+#define DS3231_A1IE 0x01
+#define DS3231_OSF 0x80
+#define DS3231_EN32KHZ 0x08
+#define DS3231_A2F 0x02
+#define DS3231_A1F 0x01
+#define DS3231_FLAGS (DS3231_OSF | DS3231_A2F | DS3231_A1F)
+
+/**
+ * Pin, na který je připojen výstup INT/SQW čipu DS3231 (otevřený kolektor, aktivní v 0)
+ */
+#ifdef SPI_PIN_LAYOUT
+#define RTC_INT_PIN 2
+#else
+#define RTC_INT_PIN 12
+#endif
+
+/**
+ * Výsledek přenosu, který běží na pozadí
+ */
+enum RtcRequestStatus {
+    RTC_REQUEST_PENDING,
+    RTC_REQUEST_DONE,
+    RTC_REQUEST_FAILED
+};
+
+void initRtc();
+bool readRtcRegisters(uint8_t firstRegister, uint8_t* data, uint8_t length);
+bool writeRtcRegisters(uint8_t firstRegister, const uint8_t* data, uint8_t length);
+bool requestRtcTimeRead();
+bool requestRtcTimeWrite(const uint8_t* registers);
+uint8_t completeRtcTimeRequest(uint8_t* registers);
+bool requestRtcTemperatureRead();
+uint8_t completeRtcTemperatureRequest(int16_t* quarterDegrees);
+bool requestRtcAlarmWrite(uint8_t hours, uint8_t mins, uint8_t seconds, bool enabled);
+uint8_t completeRtcAlarmRequest();
+bool requestRtcFlagsRead();
+uint8_t completeRtcFlagsRequest(uint8_t* flags);
+bool hasRtcLostPower();
+void clearRtcLostPower();
+bool clearRtcFlags(uint8_t flags);
+void setRtcMinuteInterrupt(bool enabled);
+bool isRtcInterruptActive();
+void rtcPinChanged();
+bool takeRtcInterrupt();
+uint8_t bcdToBinary(uint8_t bcd);
+uint8_t binaryToBcd(uint8_t value);
+
+#endif
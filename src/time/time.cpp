@@ -1,30 +1,47 @@
 #include "time.hpp"
-#include <EEPROM.h>
-#include <Wire.h>
+
+#include "buzzer/buzzer.hpp"
+#include "memory/memory.hpp"
+#include "settings/settings.hpp"
+#include "tick/tick.hpp"
+#include "time/rtc.hpp"
+#include "trace/trace.hpp"
+
 /**
- * @brief Číslo, které se uloží na 0 adresu v paměti EEPROM, abychom věděli, že tam jsou již uložené naše data
- * 
+ * @brief Registry sekund, minut a hodin v BCD, načtené z čipu reálného času a posouvané tickem
  */
-#define EEPROM_MAGIC_NUMBER 23
+uint8_t lastTimeRegisters[DS3231_TIME_REGISTERS];
+
 /**
- * @brief Výčet adres, kde máme uložená data v paměti EEPROM
- * 
+ * @brief Ticky od začátku aktuální sekundy a celé sekundy, které tick napočítal a getTime ještě nepřičetlo
  */
-enum EepromSaveAddresses {
-    MAGIC_NUMBER_ADDRESS,
-    ALARM_STATUS_ADDRESS,
-    ALARM_HOURS_ADDRESS,
-    ALARM_MINUTES_ADDRESS
-};
+uint16_t secondTicks = 0;
+volatile uint8_t pendingSeconds = 0;
+
+/**
+ * @brief Minuty od posledního přečtení času z čipu a zdali se má čas přečíst hned, protože ten v registrech neplatí
+ */
+uint8_t minutesSinceResync = 0;
+bool resyncRequested = true;
+TimeDrift timeDrift = {0, 0, 0};
+
 /**
- * @brief Objekt, pomocí kterého můžeme komunikovat s čipem reálných hodin na desce
+ * @brief Přenos času, který právě běží na pozadí, a zdali se má nastavený čas teprve zapsat do čipu
  */
-DS3231 rtc;
+enum TimeRequest {
+    TIME_REQUEST_NONE,
+    TIME_REQUEST_READ,
+    TIME_REQUEST_WRITE
+};
+uint8_t timeRequest = TIME_REQUEST_NONE;
+bool timeWritePending = false;
 
 /**
  * @brief Datová struktura, který si v sobě uchovává data od uživatele, když nastavuje čas
  */
 Time settingsTime;
+uint8_t settingsSnoozeMinutes;
+bool settingsAlarmOn;
 
 /**
  * @brief Datová struktura na udržení informací o buzení uživatele
@@ -32,37 +49,269 @@ Time settingsTime;
 AlarmSettings alarmSettings;
 
 /**
- * @brief Logická hodnota, zdali má sirénka na buzení pískat, či nikoliv
+ * @brief Kolikrát už bylo aktuální buzení odloženo, zdali buzení čeká na konec odkladu a kdy odklad skončí
+ * Konec odkladu se drží i v RAM, aby ho šlo do čipu reálného času zapsat znovu, když se zápis nepovede.
  */
-bool alarmRinging;
+uint8_t snoozeCount = 0;
+bool snoozeActive = false;
+Time snoozeEnd;
 
 /**
- * @brief Inicializuje čip reálných hodin a nastaví na něm správný čas
+ * @brief Přenos alarmu, který právě běží na pozadí, zdali se má alarm 1 teprve zapsat do čipu
+ * a zdali se mají z čipu přečíst příznaky alarmu
+ */
+enum AlarmRequest {
+    ALARM_REQUEST_NONE,
+    ALARM_REQUEST_PROGRAM,
+    ALARM_REQUEST_FLAGS
+};
+uint8_t alarmRequest = ALARM_REQUEST_NONE;
+bool alarmProgramPending = false;
+bool alarmCheckPending = false;
+
+MEMORY_FOOTPRINT(time, sizeof(lastTimeRegisters) + sizeof(secondTicks) + sizeof(pendingSeconds) +
+                 sizeof(minutesSinceResync) + sizeof(resyncRequested) + sizeof(timeDrift) +
+                 sizeof(timeRequest) + sizeof(timeWritePending) + sizeof(settingsTime) + sizeof(settingsSnoozeMinutes) + sizeof(settingsAlarmOn) + sizeof(alarmSettings) +
+                 sizeof(snoozeCount) + sizeof(snoozeActive) + sizeof(snoozeEnd) + sizeof(alarmRequest) +
+                 sizeof(alarmProgramPending) + sizeof(alarmCheckPending));
+
+void programAlarm();
+void ringAlarm();
+void traceTime(uint8_t type, const uint8_t* registers);
+void convertTo24HourMode();
+
+/**
+ * @brief Inicializuje čip reálných hodin, výchozí čas na něm nastaví jen tehdy, když čip ztratil napájení
+ * Čas udržovaný z baterie tak restart ani výpadek napájení Arduina nepřepíše. Jen při startu se na první
+ * přečtení času čeká, aby display hned ukazoval platný čas.
  * 
- * @param hours Hodiny, které chceme nastavit na čip
- * @param mins Minuty, které chceme nastavit na čip
- * @param seconds Sekundy, které chceme nastavit na čip
+ * @param hours Hodiny, které se nastaví, pokud čas v čipu není platný
+ * @param mins Minuty, které se nastaví, pokud čas v čipu není platný
+ * @param seconds Sekundy, které se nastaví, pokud čas v čipu není platný
  */
 void initTime(uint8_t hours, uint8_t mins, uint8_t seconds) {
-    Wire.begin();
-    rtc.setHour(hours);
-    rtc.setMinute(mins);
-    rtc.setSecond(seconds);
+    initRtc();
+    if (hasRtcLostPower()) {
+        Time time = {
+            .hours = hours,
+            .mins = mins,
+            .seconds = seconds};
+        setTime(time);
+        clearRtcLostPower();
+    } else if (readRtcRegisters(DS3231_SECONDS_REGISTER, lastTimeRegisters, DS3231_TIME_REGISTERS)) {
+        resyncRequested = false;
+        if (lastTimeRegisters[DS3231_HOURS_REGISTER] & DS3231_12_HOUR_MODE) {
+            convertTo24HourMode();
+        }
+        traceTime(TRACE_RTC, lastTimeRegisters);
+    }
+}
+
+/**
+ * @brief Převede hodiny přečtené z čipu ve 12 hodinovém módu (jiným programem) na 24 hodinový mód a zapíše je zpět
+ * Zapíše se jen registr hodin, dělič sekund čipu se tak nevynuluje. Nepovedený zápis zopakuje serviceTime celým časem.
+ */
+void convertTo24HourMode() {
+    uint8_t hours = lastTimeRegisters[DS3231_HOURS_REGISTER];
+    uint8_t value = bcdToBinary(hours & DS3231_12_HOURS_MASK) % 12;
+    if (hours & DS3231_PM) {
+        value += 12;
+    }
+    lastTimeRegisters[DS3231_HOURS_REGISTER] = binaryToBcd(value);
+    if (!writeRtcRegisters(DS3231_HOURS_REGISTER, &lastTimeRegisters[DS3231_HOURS_REGISTER], 1)) {
+        timeWritePending = true;
+    }
+}
+
+/**
+ * @brief Volá se z ticku, každých TICK_FREQUENCY ticků uplyne jedna sekunda
+ * 
+ */
+void timeTick() {
+    if (++secondTicks >= TICK_FREQUENCY) {
+        secondTicks = 0;
+        pendingSeconds++;
+    }
 }
 
 /**
- * @brief Zjistí a vrátí čas z čipu reálného času
+ * @brief Přičte jedničku k hodnotě v BCD
+ * 
+ * @param value Hodnota v BCD
+ * @param max Největší hodnota v BCD, po ní následuje 0
+ * @return true Pokud hodnota přetekla na 0
+ */
+bool incrementBcd(uint8_t* value, uint8_t max) {
+    if (*value >= max) {
+        *value = 0;
+        return true;
+    }
+    *value = (*value & 0x0F) == 9 ? (*value & 0xF0) + 0x10 : *value + 1;
+    return false;
+}
+
+/**
+ * @brief Posune čas v registrech o zadaný počet sekund, při každé celé minutě se posune i počítadlo do přečtení čipu
+ * 
+ * @param seconds Počet sekund
+ */
+void advanceTime(uint8_t seconds) {
+    for (; seconds > 0; seconds--) {
+        if (!incrementBcd(&lastTimeRegisters[DS3231_SECONDS_REGISTER], 0x59)) {
+            continue;
+        }
+        minutesSinceResync++;
+        if (incrementBcd(&lastTimeRegisters[DS3231_MINUTES_REGISTER], 0x59)) {
+            lastTimeRegisters[DS3231_HOURS_REGISTER] &= DS3231_HOURS_MASK;
+            incrementBcd(&lastTimeRegisters[DS3231_HOURS_REGISTER], 0x23);
+        }
+    }
+}
+
+/**
+ * @brief Převede čas v BCD registrech na sekundy od půlnoci
+ */
+int32_t registersToSeconds(const uint8_t* registers) {
+    return bcdToBinary(registers[DS3231_HOURS_REGISTER] & DS3231_HOURS_MASK) * 3600L +
+           bcdToBinary(registers[DS3231_MINUTES_REGISTER]) * 60L + bcdToBinary(registers[DS3231_SECONDS_REGISTER]);
+}
+
+/**
+ * @brief Přičte sekundy, které od posledního volání napočítal tick
+ */
+void collectSeconds() {
+    noInterrupts();
+    uint8_t seconds = pendingSeconds;
+    pendingSeconds = 0;
+    interrupts();
+    advanceTime(seconds);
+}
+
+/**
+ * @brief Zapíše do záznamu událostí čas z BCD registrů
+ */
+void traceTime(uint8_t type, const uint8_t* registers) {
+    traceEvent(type, bcdToBinary(registers[DS3231_HOURS_REGISTER] & DS3231_HOURS_MASK),
+               bcdToBinary(registers[DS3231_MINUTES_REGISTER]), bcdToBinary(registers[DS3231_SECONDS_REGISTER]));
+}
+
+/**
+ * @brief Převezme čas přečtený z čipu reálného času a změří, o kolik se od něj čas počítaný tickem odchýlil
+ * 
+ * @param registers Sekundy, minuty a hodiny v BCD přečtené z čipu
+ */
+void applyResync(const uint8_t* registers) {
+    traceTime(TRACE_RTC, registers);
+    if (!resyncRequested) {
+        int32_t drift = registersToSeconds(lastTimeRegisters) - registersToSeconds(registers);
+        // odchylka přes půlnoc
+        if (drift > SECONDS_IN_DAY / 2) {
+            drift -= SECONDS_IN_DAY;
+        } else if (drift < -SECONDS_IN_DAY / 2) {
+            drift += SECONDS_IN_DAY;
+        }
+        timeDrift.seconds = drift;
+        timeDrift.minutes = minutesSinceResync;
+        timeDrift.resyncs++;
+    }
+    for (uint8_t i = 0; i < DS3231_TIME_REGISTERS; i++) {
+        lastTimeRegisters[i] = registers[i];
+    }
+    minutesSinceResync = 0;
+    resyncRequested = false;
+}
+
+/**
+ * @brief Vyzvedne dokončený přenos času a podle potřeby začne další, na sběrnici I2C nikdy nečeká
+ * Nastavený čas se zapíše do čipu, jinak se čas z čipu přečte jednou za TIME_RESYNC_MINUTES minut nebo na vyžádání.
+ * Neúspěšný přenos se zopakuje až při dalším periodickém volání, čas mezitím běží dál podle ticku.
+ * Volá se periodicky a hned po každém přerušení, kterým ovladač TWI dokončí přenos.
+ * 
+ */
+void serviceTime() {
+    collectSeconds();
+    if (timeRequest != TIME_REQUEST_NONE) {
+        uint8_t registers[DS3231_TIME_REGISTERS];
+        uint8_t status = completeRtcTimeRequest(registers);
+        if (status == RTC_REQUEST_PENDING) {
+            return;
+        }
+        uint8_t finished = timeRequest;
+        timeRequest = TIME_REQUEST_NONE;
+        if (status == RTC_REQUEST_FAILED) {
+            // odpojený čip nebo rušení, přenos se zopakuje až při dalším periodickém volání
+            timeWritePending = timeWritePending || finished == TIME_REQUEST_WRITE;
+            return;
+        }
+        if (finished == TIME_REQUEST_WRITE) {
+            minutesSinceResync = 0;
+            resyncRequested = false;
+        } else if (!timeWritePending) {
+            // čtení, které začalo před nastavením času, už neplatí
+            applyResync(registers);
+        }
+    }
+    if (timeWritePending) {
+        if (requestRtcTimeWrite(lastTimeRegisters)) {
+            // zápis sekund vynuluje dělič čipu, začátek sekundy v ticku tak sedí přesně na čip
+            noInterrupts();
+            secondTicks = 0;
+            pendingSeconds = 0;
+            interrupts();
+            timeWritePending = false;
+            timeRequest = TIME_REQUEST_WRITE;
+        }
+    } else if (resyncRequested || minutesSinceResync >= TIME_RESYNC_MINUTES) {
+        if (requestRtcTimeRead()) {
+            timeRequest = TIME_REQUEST_READ;
+        }
+    }
+}
+
+/**
+ * @brief Vrátí aktuální čas, který počítá tick, s čipem reálného času nekomunikuje, to dělá serviceTime
  * 
  * @return Aktuální čas hodin
  */
 Time getTime() {
-    bool h12Flag, pmFlag;
+    collectSeconds();
     Time currentTime = {
-        .hours = rtc.getHour(h12Flag, pmFlag),
-        .mins = rtc.getMinute(),
-        .seconds = rtc.getSecond()};
+        .hours = bcdToBinary(lastTimeRegisters[DS3231_HOURS_REGISTER] & DS3231_HOURS_MASK),
+        .mins = bcdToBinary(lastTimeRegisters[DS3231_MINUTES_REGISTER]),
+        .seconds = bcdToBinary(lastTimeRegisters[DS3231_SECONDS_REGISTER])};
     return currentTime;
 }
+
+/**
+ * @brief Vyžádá si přečtení času z čipu při příštím volání serviceTime, například když tick stál
+ * 
+ */
+void requestTimeResync() {
+    resyncRequested = true;
+}
+
+/**
+ * @brief Vrátí odchylku času počítaného tickem naměřenou při posledním přečtení čipu
+ */
+TimeDrift getTimeDrift() {
+    return timeDrift;
+}
+
+/**
+ * @brief Vrátí číslice času z posledního volání getTime rovnou z BCD registrů, bez dělení a bez komunikace s čipem
+ * 
+ * @return Číslice hodin a minut pro display
+ */
+TimeDigits getTimeDigits() {
+    uint8_t hours = lastTimeRegisters[DS3231_HOURS_REGISTER] & DS3231_HOURS_MASK;
+    uint8_t mins = lastTimeRegisters[DS3231_MINUTES_REGISTER];
+    TimeDigits digits = {
+        .hoursTens = (uint8_t)(hours >> 4),
+        .hoursOnes = (uint8_t)(hours & 0x0F),
+        .minsTens = (uint8_t)(mins >> 4),
+        .minsOnes = (uint8_t)(mins & 0x0F)};
+    return digits;
+}
 /**
  * @brief Připravý data na nastavení času uživatelem
  * 
@@ -72,6 +321,8 @@ Time getTime() {
 void prepareSettingsTime(bool forAlarmSetting) {
     if (forAlarmSetting) {
         settingsTime = alarmSettings.ringTime;
+        settingsSnoozeMinutes = alarmSettings.snoozeMinutes;
+        settingsAlarmOn = alarmSettings.on;
     } else {
         settingsTime = getTime();
     }
@@ -104,6 +355,40 @@ void incrementMinute() {
 void decrementMinute() {
     settingsTime.mins = settingsTime.mins == 0 ? MINUTES_IN_HOUR - 1 : settingsTime.mins - 1;
 }
+/**
+ * @brief Zvýší aktuální minutu o 10, při držení tlačítka TIME+
+ */
+void incrementTenMinutes() {
+    settingsTime.mins = (settingsTime.mins + 10) % MINUTES_IN_HOUR;
+}
+
+/**
+ * @brief Sníží aktuální minutu o 10, při držení tlačítka TIME-
+ */
+void decrementTenMinutes() {
+    settingsTime.mins = (settingsTime.mins + MINUTES_IN_HOUR - 10) % MINUTES_IN_HOUR;
+}
+/**
+ * @brief Prodlouží nastavovaný odklad buzení o 1 minutu
+ */
+void incrementSnoozeMinutes() {
+    settingsSnoozeMinutes = settingsSnoozeMinutes < MAX_SNOOZE_MINUTES ? settingsSnoozeMinutes + 1 : 1;
+}
+
+/**
+ * @brief Zkrátí nastavovaný odklad buzení o 1 minutu
+ */
+void decrementSnoozeMinutes() {
+    settingsSnoozeMinutes = settingsSnoozeMinutes > 1 ? settingsSnoozeMinutes - 1 : MAX_SNOOZE_MINUTES;
+}
+
+/**
+ * @brief Vrátí délku odkladu buzení, kterou nastavil uživatel
+ * @return Délka odkladu v minutách
+ */
+uint8_t getSettingsSnoozeMinutes() {
+    return settingsSnoozeMinutes;
+}
 /**
  * @brief Vrátí čas, který nastavit uživatel
  * @return Čas nastavený uživatelem
@@ -112,46 +397,62 @@ Time getSettingsTime() {
     return settingsTime;
 }
 /**
- * @brief Nastaví čas na desce a v čipu reálného času
+ * @brief Nastaví čas na desce a začne ho na pozadí zapisovat do čipu reálného času, všechny registry času jedním přenosem
+ * Nastavený čas platí hned, pokud zápis selže, serviceTime ho zopakuje s aktuálním časem.
  * 
  * @param time Čas, který cheme nastavi
  */
 void setTime(Time time) {
-    rtc.setHour(time.hours);
-    rtc.setMinute(time.mins);
-    rtc.setSecond(time.seconds);
+    lastTimeRegisters[DS3231_SECONDS_REGISTER] = binaryToBcd(time.seconds);
+    lastTimeRegisters[DS3231_MINUTES_REGISTER] = binaryToBcd(time.mins);
+    lastTimeRegisters[DS3231_HOURS_REGISTER] = binaryToBcd(time.hours);  // 24 hodinový mód
+    noInterrupts();
+    secondTicks = 0;
+    pendingSeconds = 0;
+    interrupts();
+    timeWritePending = true;
+    traceEvent(TRACE_TIME_SET, time.hours, time.mins, time.seconds);
+    serviceTime();
 }
 /**
- * @brief Inicializuje nastavení budíku v paměti EEPROM
+ * @brief Načte nastavení budíku z paměti EEPROM, pokud tam žádné není, použije výchozí nastavení
+ * EEPROM se při tom nijak nepřepisuje, první záznam se uloží až při první změně nastavení.
  * 
  */
 void initAlarmSettings() {
-    uint8_t magicNumber = EEPROM.read(MAGIC_NUMBER_ADDRESS);
-    if (magicNumber == EEPROM_MAGIC_NUMBER) {
-        // Data are saved in eeprom, time to load them
-        alarmSettings = {
-            .ringTime = {
-                .hours = EEPROM.read(ALARM_HOURS_ADDRESS),
-                .mins = EEPROM.read(ALARM_MINUTES_ADDRESS),
-                .seconds = 0},
-            .on = EEPROM.read(ALARM_STATUS_ADDRESS) == 1};
-    } else {
-        // Data are not saved in eeprom, time to prepare EEPROM and generateData
+    if (!loadSettings(&alarmSettings)) {
         alarmSettings = {
             .ringTime = {
                 .hours = 0,
                 .mins = 0,
                 .seconds = 0},
-            .on = false};
-        for (uint16_t i = 0; i < EEPROM.length(); i++) {
-            // erase eeprom
-            EEPROM.write(i, 0);
-        }
-        // now is eeprom prepared for write and reading
-        EEPROM.write(MAGIC_NUMBER_ADDRESS, EEPROM_MAGIC_NUMBER);
+            .on = false,
+            .snoozeMinutes = DEFAULT_SNOOZE_MINUTES};
     }
-    alarmRinging = false;
-    pinMode(ALARM_PIN, OUTPUT);
+    initBuzzer();
+    programAlarm();
+}
+
+/**
+ * @brief Naplánuje do alarmu 1 čipu reálného času konec odkladu, nebo denní buzení
+ * Zápis jen začne na pozadí, dokončí ho a nepovedený zopakuje serviceAlarm, na sběrnici se tak nikdy nečeká.
+ * 
+ */
+void programAlarm() {
+    alarmProgramPending = true;
+    serviceAlarm();
+}
+
+/**
+ * @brief Začne na pozadí zápis konce odkladu, nebo denního buzení do alarmu 1 čipu reálného času
+ * 
+ * @return false Pokud sběrnice zrovna přenáší něco jiného
+ */
+bool requestAlarmProgram() {
+    if (snoozeActive) {
+        return requestRtcAlarmWrite(snoozeEnd.hours, snoozeEnd.mins, snoozeEnd.seconds, true);
+    }
+    return requestRtcAlarmWrite(alarmSettings.ringTime.hours, alarmSettings.ringTime.mins, 0, alarmSettings.on);
 }
 /**
  * @brief Vrací nastavení alarmu
@@ -161,44 +462,129 @@ AlarmSettings getAlarmSettings() {
     return alarmSettings;
 }
 /**
- * @brief Nastaví čas, kdy alarm bude vyzvánět
+ * @brief Nastaví čas, kdy alarm bude vyzvánět, do EEPROM se uloží až v commitAlarmSettings
  * @param time Čas vyzvánění alarmu
  */
 
 void setAlarmTime(Time time) {
     alarmSettings.ringTime = time;
-    EEPROM.write(ALARM_HOURS_ADDRESS, time.hours);
-    EEPROM.write(ALARM_MINUTES_ADDRESS, time.mins);
 }
+
 /**
- * @brief Změní stav alarmu na z on na off a z off na on
+ * @brief Nastaví délku odkladu buzení, do EEPROM se uloží až v commitAlarmSettings
+ * @param minutes Délka odkladu v minutách od 1 do MAX_SNOOZE_MINUTES
+ */
+void setSnoozeMinutes(uint8_t minutes) {
+    alarmSettings.snoozeMinutes = minutes;
+}
+/**
+ * @brief Změní stav alarmu na z on na off a z off na on, do EEPROM se uloží až v commitAlarmSettings
  * 
  */
 
 void toggleAlarmStatus() {
     alarmSettings.on = !alarmSettings.on;
-    EEPROM.write(ALARM_STATUS_ADDRESS, alarmSettings.on);
 }
+
 /**
- * @brief Kontroluje periodicky, zdali je čas zapnout alarm či nikoliv 
- * @param currentTime 
+ * @brief Vrátí zapnutí alarmu na stav před vstupem do nastavení alarmu, když uživatel nastavení zruší
+ * 
  */
-void checkAlarm(Time currentTime) {
-    if (!alarmSettings.on || currentTime.seconds != 0) {
-        return;
+void revertAlarmStatus() {
+    alarmSettings.on = settingsAlarmOn;
+}
+
+/**
+ * @brief Zapne nebo vypne alarm, do EEPROM se uloží až v commitAlarmSettings
+ * @param on True pokud má alarm budit
+ */
+void setAlarmStatus(bool on) {
+    alarmSettings.on = on;
+}
+
+/**
+ * @brief Uloží nastavení budíku do EEPROM a naprogramuje ho do alarmu 1 čipu reálného času
+ * Volá se až při opuštění módu nastavení alarmu, všechny změny během nastavování se tak zapíší najednou.
+ * 
+ */
+void commitAlarmSettings() {
+    saveSettings(alarmSettings);
+    programAlarm();
+}
+/**
+ * @brief Vyžádá si přečtení příznaků alarmu z čipu při příštím volání serviceAlarm
+ * Volá se po přerušení od pinu INT čipu a pro jistotu i periodicky.
+ * 
+ */
+void requestAlarmCheck() {
+    alarmCheckPending = true;
+}
+
+/**
+ * @brief Vyzvedne dokončený přenos alarmu a podle potřeby začne další, na sběrnici I2C nikdy nečeká
+ * Když čip příznakem A1F ohlásí čas buzení nebo konec odkladu, spustí alarm. Čas buzení hlídá sám čip,
+ * takže alarm nejde zmeškat, ani když se příznak zpracuje se zpožděním. Příznak A1F smaže až nový zápis
+ * alarmu 1, ten má proto přednost před dalším čtením příznaků, aby jeden příznak nespustil alarm dvakrát.
+ * Neúspěšný přenos se zopakuje až při dalším volání, volá se periodicky a po každém dokončeném přenosu.
+ * 
+ */
+void serviceAlarm() {
+    if (alarmRequest != ALARM_REQUEST_NONE) {
+        uint8_t flags = 0;
+        uint8_t status = alarmRequest == ALARM_REQUEST_PROGRAM ? completeRtcAlarmRequest()
+                                                               : completeRtcFlagsRequest(&flags);
+        if (status == RTC_REQUEST_PENDING) {
+            return;
+        }
+        uint8_t finished = alarmRequest;
+        alarmRequest = ALARM_REQUEST_NONE;
+        if (status == RTC_REQUEST_FAILED) {
+            // odpojený čip nebo rušení, přenos se zopakuje až při dalším volání
+            alarmProgramPending = alarmProgramPending || finished == ALARM_REQUEST_PROGRAM;
+            alarmCheckPending = alarmCheckPending || finished == ALARM_REQUEST_FLAGS;
+            return;
+        }
+        if (flags & DS3231_A1F) {
+            ringAlarm();
+        }
     }
-    if (currentTime.hours == alarmSettings.ringTime.hours && currentTime.mins == alarmSettings.ringTime.mins) {
-        digitalWrite(ALARM_PIN, HIGH);
-        alarmRinging = true;
+    if (alarmProgramPending) {
+        if (requestAlarmProgram()) {
+            alarmProgramPending = false;
+            alarmRequest = ALARM_REQUEST_PROGRAM;
+        }
+    } else if (alarmCheckPending) {
+        if (requestRtcFlagsRead()) {
+            alarmCheckPending = false;
+            alarmRequest = ALARM_REQUEST_FLAGS;
+        }
     }
 }
+
+/**
+ * @brief Zpracuje příznak A1F: po odkladu vrátí alarm 1 na denní čas buzení a pokud má alarm zvonit, spustí ho
+ * 
+ */
+void ringAlarm() {
+    // nový zápis alarmu 1 zároveň smaže příznak A1F
+    alarmProgramPending = true;
+    if (snoozeActive) {
+        snoozeActive = false;
+    } else if (alarmSettings.on) {
+        snoozeCount = 0;
+    } else {
+        return;
+    }
+    traceEvent(TRACE_ALARM, TRACE_ALARM_RING, snoozeCount, 0);
+    playPattern(PATTERN_ALARM);
+}
 /**
  * @brief Data o tom, zdali alarm právě zvoní
  * @return true Pokud zvoní
  * @return false Pokud nezvoní
  */
 bool isAlarmRinging(){
-    return alarmRinging;
+    return isBuzzerPlaying();
 }
 
 /**
@@ -206,6 +592,58 @@ bool isAlarmRinging(){
  * 
  */
 void turnOffAlarm() {
-    digitalWrite(ALARM_PIN, LOW);
-    alarmRinging = false;
+    traceEvent(TRACE_ALARM, TRACE_ALARM_OFF, snoozeCount, 0);
+    stopBuzzer();
+    snoozeCount = 0;
+    if (snoozeActive) {
+        snoozeActive = false;
+        programAlarm();
+    }
+}
+
+/**
+ * @brief Odloží zvonící alarm o nastavenou délku odkladu, nejvýše MAX_SNOOZES krát za sebou
+ * Konec odkladu se spočítá jednou a naplánuje do alarmu 1 čipu reálného času, který pak sám ohlásí,
+ * že má alarm znovu zvonit, i kdyby byla hlavní smyčka zrovna zaneprázdněná. Když čip zápis nepotvrdí,
+ * serviceAlarm ho opakuje, dokud neprojde.
+ * 
+ */
+void snoozeAlarm() {
+    if (!isBuzzerPlaying() || snoozeCount >= MAX_SNOOZES) {
+        return;
+    }
+    stopBuzzer();
+    snoozeCount++;
+    traceEvent(TRACE_ALARM, TRACE_ALARM_SNOOZE, snoozeCount, 0);
+    snoozeActive = true;
+    snoozeEnd = getTime();
+    snoozeEnd.mins += alarmSettings.snoozeMinutes;
+    if (snoozeEnd.mins >= MINUTES_IN_HOUR) {
+        snoozeEnd.mins -= MINUTES_IN_HOUR;
+        snoozeEnd.hours = snoozeEnd.hours + 1 < HOURS_IN_DAY ? snoozeEnd.hours + 1 : 0;
+    }
+    programAlarm();
+}
+
+/**
+ * @brief Data o tom, zdali je buzení právě odložené
+ * @return true Pokud se čeká na konec odkladu
+ */
+bool isAlarmSnoozed() {
+    return snoozeActive;
+}
+
+/**
+ * @brief Zjistí, zdali čas leží v rozmezí celých hodin, rozmezí může přecházet přes půlnoc (např. 22 až 6)
+ * 
+ * @param time Čas, který se porovnává
+ * @param startHour První hodina rozmezí
+ * @param endHour Hodina, kterou rozmezí končí, do rozmezí už nepatří
+ * @return true Pokud čas leží v rozmezí
+ */
+bool isTimeBetweenHours(Time time, uint8_t startHour, uint8_t endHour) {
+    if (startHour <= endHour) {
+        return time.hours >= startHour && time.hours < endHour;
+    }
+    return time.hours >= startHour || time.hours < endHour;
 }
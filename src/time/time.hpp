@@ -1,11 +1,24 @@
 #ifndef __TIME__HPP__
 #define __TIME__HPP__
 #include <Arduino.h>
-#include <DS3231.h>
 
 #define HOURS_IN_DAY 24
 #define MINUTES_IN_HOUR 60
-#define ALARM_PIN 7
+#define SECONDS_IN_MINUTE 60
+#define SECONDS_IN_DAY 86400L
+/**
+ * Odklad buzení tlačítkem SNOOZE: výchozí a největší délka odkladu v minutách a kolikrát lze buzení odložit
+ */
+#define DEFAULT_SNOOZE_MINUTES 9
+#define MAX_SNOOZE_MINUTES 30
+#define MAX_SNOOZES 3
+/**
+ * Sekundy počítá tick, čas se z čipu reálného času přečte na pozadí jen jednou za TIME_RESYNC_MINUTES minut,
+ * po nepovedeném zápisu a po probuzení z režimu power-down, kdy tick neběží
+ */
+#ifndef TIME_RESYNC_MINUTES
+#define TIME_RESYNC_MINUTES 10
+#endif
 
 
 struct Time{
@@ -14,26 +27,64 @@ struct Time{
     byte seconds;
 };
 
+/**
+ * Číslice času pro display, získané přímo z BCD registrů čipu reálného času
+ */
+struct TimeDigits{
+    uint8_t hoursTens;
+    uint8_t hoursOnes;
+    uint8_t minsTens;
+    uint8_t minsOnes;
+};
+
+/**
+ * Odchylka času počítaného tickem od čipu reálného času, naměřená při posledním přečtení času z čipu
+ */
+struct TimeDrift{
+    int16_t seconds;   // o kolik sekund tick čip předběhl, záporné pokud se zpožďoval
+    uint8_t minutes;   // za kolik minut od předchozího přečtení se odchylka nasbírala
+    uint16_t resyncs;  // počet měření od startu
+};
+
 struct AlarmSettings{
     Time ringTime;
     bool on;
+    uint8_t snoozeMinutes;
 };
 
 Time getTime();
+void serviceTime();
+TimeDigits getTimeDigits();
+void timeTick();
+void requestTimeResync();
+TimeDrift getTimeDrift();
 void initTime(uint8_t hours, uint8_t mins, uint8_t seconds);
 void prepareSettingsTime(bool forAlarmSetting);
 void incrementHour();
 void decrementHour();
 void incrementMinute();
 void decrementMinute();
+void incrementTenMinutes();
+void decrementTenMinutes();
+void incrementSnoozeMinutes();
+void decrementSnoozeMinutes();
 Time getSettingsTime();
+uint8_t getSettingsSnoozeMinutes();
 void setTime(Time time);
 AlarmSettings getAlarmSettings();
 void setAlarmTime(Time time);
+void setSnoozeMinutes(uint8_t minutes);
 void toggleAlarmStatus();
+void revertAlarmStatus();
+void setAlarmStatus(bool on);
+void commitAlarmSettings();
 void initAlarmSettings();
-void checkAlarm(Time currentTime);
+void requestAlarmCheck();
+void serviceAlarm();
 void turnOffAlarm();
+void snoozeAlarm();
 bool isAlarmRinging();
+bool isAlarmSnoozed();
+bool isTimeBetweenHours(Time time, uint8_t startHour, uint8_t endHour);
 
 #endif
\ No newline at end of file
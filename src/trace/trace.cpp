@@ -0,0 +1,44 @@
+#include "trace.hpp"
+
+#include <Arduino.h>
+
+#include "memory/memory.hpp"
+
+/**
+ * @brief Kruhový buffer záznamů a počet všech zapsaných záznamů, který zároveň určuje pořadové číslo záznamu
+ * Počet přetéká, záznam s pořadovým číslem n leží na indexu n & TRACE_MASK.
+ */
+TraceRecord traceBuffer[TRACE_LENGTH];
+uint16_t traceCount = 0;
+
+MEMORY_FOOTPRINT(trace, sizeof(traceBuffer) + sizeof(traceCount));
+
+/**
+ * @brief Vrátí počet zapsaných záznamů, tedy pořadové číslo příštího záznamu
+ */
+uint16_t getTraceCount() {
+    return traceCount;
+}
+
+/**
+ * @brief Vrátí aktuální čas ve stejných jednotkách jako čas záznamů
+ */
+uint16_t getTraceTime() {
+    return millis() >> TRACE_TIME_SHIFT;
+}
+
+/**
+ * @brief Zkopíruje záznam s daným pořadovým číslem
+ *
+ * @param sequence Pořadové číslo záznamu
+ * @param record Kam se záznam zkopíruje
+ * @return false Pokud záznam ještě nevznikl nebo už byl přepsán
+ */
+bool getTraceRecord(uint16_t sequence, TraceRecord* record) {
+    uint16_t age = traceCount - sequence;
+    if (age == 0 || age > TRACE_LENGTH) {
+        return false;
+    }
+    *record = traceBuffer[sequence & TRACE_MASK];
+    return true;
+}
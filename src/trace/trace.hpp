@@ -0,0 +1,76 @@
+#ifndef __TRACE__HPP__
+#define __TRACE__HPP__
+#include <Arduino.h>
+
+/**
+ * Záznam událostí hlavní smyčky pro hledání chyb v provozu: kruhový buffer posledních TRACE_LENGTH událostí
+ * (tlačítka, přečtený a nastavený čas, přechody uživatelského rozhraní a buzení) s časem v jednotkách
+ * 2^TRACE_TIME_SHIFT ms. Buffer se čte po sériové lince (tools/clockctl.py trace) a simulátor ho umí
+ * přehrát přepínačem --replay. Zápis je jen pár instrukcí, záznam proto běží vždy.
+ *
+ * Zapisuje se jen z hlavní smyčky, nikdy z přerušení, takže zápis nemusí zakazovat přerušení.
+ */
+#ifndef TRACE_LENGTH
+#define TRACE_LENGTH 32
+#endif
+#define TRACE_MASK (TRACE_LENGTH - 1)
+#define TRACE_TIME_SHIFT 6
+#define TRACE_DATA_LENGTH 3
+
+static_assert((TRACE_LENGTH & TRACE_MASK) == 0, "TRACE_LENGTH has to be a power of two");
+
+/**
+ * Druhy záznamů, data záznamu:
+ * TRACE_BUTTON - událost tlačítka z fronty (index tlačítka, případně s BUTTON_EVENT_RELEASED)
+ * TRACE_RTC - čas přečtený z čipu reálného času (hodiny, minuty, sekundy)
+ * TRACE_TIME_SET - nastavený čas (hodiny, minuty, sekundy)
+ * TRACE_UI - přechod rozhraní (původní stav, nový stav, událost nebo TRACE_UI_TIMEOUT)
+ * TRACE_ALARM - buzení (TraceAlarm, počet odkladů)
+ */
+enum TraceType {
+    TRACE_EMPTY,
+    TRACE_BUTTON,
+    TRACE_RTC,
+    TRACE_TIME_SET,
+    TRACE_UI,
+    TRACE_ALARM
+};
+
+/**
+ * Přechod rozhraní, který nezpůsobilo tlačítko, ale uplynutí času
+ */
+#define TRACE_UI_TIMEOUT 0xFF
+
+enum TraceAlarm {
+    TRACE_ALARM_RING,
+    TRACE_ALARM_SNOOZE,
+    TRACE_ALARM_OFF
+};
+
+struct TraceRecord {
+    uint16_t time;
+    uint8_t type;
+    uint8_t data[TRACE_DATA_LENGTH];
+};
+
+extern TraceRecord traceBuffer[TRACE_LENGTH];
+extern uint16_t traceCount;
+
+/**
+ * @brief Zapíše událost do kruhového bufferu, nejstarší záznam se přepíše
+ */
+inline void traceEvent(uint8_t type, uint8_t first, uint8_t second, uint8_t third) {
+    TraceRecord* record = &traceBuffer[traceCount & TRACE_MASK];
+    record->time = millis() >> TRACE_TIME_SHIFT;
+    record->type = type;
+    record->data[0] = first;
+    record->data[1] = second;
+    record->data[2] = third;
+    traceCount++;
+}
+
+uint16_t getTraceCount();
+uint16_t getTraceTime();
+bool getTraceRecord(uint16_t sequence, TraceRecord* record);
+
+#endif
@@ -0,0 +1,267 @@
+#include "twi.hpp"
+
+#include <Arduino.h>
+#include <avr/interrupt.h>
+
+#include "gpio/gpio.hpp"
+#include "memory/memory.hpp"
+#include "power/power.hpp"
+
+typedef GpioPin<TWI_SDA_PIN> SdaPin;
+typedef GpioPin<TWI_SCL_PIN> SclPin;
+
+/**
+ * Stavové kódy periferie TWI v režimu master (horních 5 bitů TWSR)
+ */
+#define TWI_STATUS_MASK 0xF8
+#define TWI_START 0x08
+#define TWI_REPEATED_START 0x10
+#define TWI_WRITE_ADDRESS_ACK 0x18
+#define TWI_WRITE_ADDRESS_NACK 0x20
+#define TWI_WRITE_DATA_ACK 0x28
+#define TWI_WRITE_DATA_NACK 0x30
+#define TWI_READ_ADDRESS_ACK 0x40
+#define TWI_READ_ADDRESS_NACK 0x48
+#define TWI_READ_DATA_ACK 0x50
+#define TWI_READ_DATA_NACK 0x58
+
+#define TWI_READ_BIT 0x01
+#define TWI_BIT_RATE ((F_CPU / TWI_FREQUENCY - 16) / 2)
+
+static_assert(TWI_BIT_RATE <= 255, "TWI_FREQUENCY is too low for prescaler 1");
+
+/**
+ * Periferie zapnutá s povoleným přerušením, k tomu se přidá akce TWSTA nebo TWEA
+ */
+#define TWI_CONTROL (_BV(TWEN) | _BV(TWIE) | _BV(TWINT))
+
+/**
+ * @brief Rozpracovaný přenos, dokud twiBusy platí, mění ho jen obsluha přerušení
+ * Buffer obsahuje adresu registru a data zápisu, přečtené bajty jdou rovnou do twiReadData volajícího.
+ */
+volatile bool twiBusy = false;
+uint8_t twiAddress;
+uint8_t twiBuffer[TWI_BUFFER_LENGTH];
+uint8_t twiWriteLength;
+volatile uint8_t* twiReadData;
+uint8_t twiReadLength;
+uint8_t twiIndex;
+volatile uint8_t* twiStatus;
+unsigned long twiStartMillis;
+volatile bool twiCompleted = false;
+uint16_t twiRecoveries = 0;
+
+MEMORY_FOOTPRINT(twi, sizeof(twiBusy) + sizeof(twiAddress) + sizeof(twiBuffer) + sizeof(twiWriteLength) +
+                 sizeof(twiReadData) + sizeof(twiReadLength) + sizeof(twiIndex) + sizeof(twiStatus) +
+                 sizeof(twiStartMillis) + sizeof(twiCompleted) + sizeof(twiRecoveries));
+
+/**
+ * @brief Zapne periferii TWI s frekvencí TWI_FREQUENCY, piny SDA a SCL mají interní pull-up
+ *
+ */
+void initTwi() {
+    SdaPin::setInputPullup();
+    SclPin::setInputPullup();
+    TWSR = 0;
+    TWBR = TWI_BIT_RATE;
+    TWCR = _BV(TWEN);
+}
+
+/**
+ * @brief Začne přenos podmínkou START, zbytek odbaví obsluha přerušení
+ */
+void startTransfer(uint8_t address, volatile uint8_t* status) {
+    twiAddress = address << 1;
+    twiIndex = 0;
+    twiStatus = status;
+    *status = TWI_BUSY;
+    twiStartMillis = millis();
+    twiBusy = true;
+    TWCR = TWI_CONTROL | _BV(TWSTA);
+}
+
+/**
+ * @brief Začne zápis registrů zařízení
+ *
+ * @param address 7bitová adresa zařízení
+ * @param firstRegister Adresa prvního registru
+ * @param data Hodnoty registrů, zkopírují se
+ * @param length Počet registrů, nejvýše TWI_BUFFER_LENGTH - 1
+ * @param status Kam se zapíše stav přenosu (TwiStatus), do dokončení TWI_BUSY
+ * @return false Pokud ještě běží jiný přenos
+ */
+bool startTwiWrite(uint8_t address, uint8_t firstRegister, const uint8_t* data, uint8_t length,
+                   volatile uint8_t* status) {
+    if (isTwiBusy() || length >= TWI_BUFFER_LENGTH) {
+        return false;
+    }
+    twiBuffer[0] = firstRegister;
+    for (uint8_t i = 0; i < length; i++) {
+        twiBuffer[i + 1] = data[i];
+    }
+    twiWriteLength = length + 1;
+    twiReadLength = 0;
+    startTransfer(address, status);
+    return true;
+}
+
+/**
+ * @brief Začne čtení registrů zařízení: zápis adresy registru, opakovaný START a čtení
+ *
+ * @param address 7bitová adresa zařízení
+ * @param firstRegister Adresa prvního registru
+ * @param data Kam se přečtené registry zapíšou, musí platit až do konce přenosu
+ * @param length Počet registrů
+ * @param status Kam se zapíše stav přenosu (TwiStatus), do dokončení TWI_BUSY
+ * @return false Pokud ještě běží jiný přenos
+ */
+bool startTwiRead(uint8_t address, uint8_t firstRegister, volatile uint8_t* data, uint8_t length,
+                  volatile uint8_t* status) {
+    if (isTwiBusy() || length == 0) {
+        return false;
+    }
+    twiBuffer[0] = firstRegister;
+    twiWriteLength = 1;
+    twiReadData = data;
+    twiReadLength = length;
+    startTransfer(address, status);
+    return true;
+}
+
+/**
+ * @brief Uvolní zaseknutou sběrnici
+ * Zařízení, kterému se uprostřed bajtu ztratily hodiny, drží SDA v 0, dokud nedostane zbytek pulzů SCL.
+ * Pak se ručně vytvoří podmínka STOP a periferie se znovu zapne.
+ */
+void recoverTwi() {
+    TWCR = 0;
+    SdaPin::setInputPullup();
+    for (uint8_t i = 0; i < TWI_RECOVERY_PULSES && !SdaPin::read(); i++) {
+        SclPin::low();
+        SclPin::setOutput();
+        delayMicroseconds(TWI_RECOVERY_HALF_PERIOD_MICROS);
+        SclPin::setInputPullup();
+        delayMicroseconds(TWI_RECOVERY_HALF_PERIOD_MICROS);
+    }
+    // STOP: SDA jde z 0 do 1, zatímco SCL je v 1
+    SdaPin::low();
+    SdaPin::setOutput();
+    delayMicroseconds(TWI_RECOVERY_HALF_PERIOD_MICROS);
+    SdaPin::setInputPullup();
+    twiRecoveries++;
+    initTwi();
+}
+
+/**
+ * @brief Zjistí, zdali běží přenos, přenos, který běží déle než TWI_TIMEOUT_MILLIS, zruší a obnoví sběrnici
+ *
+ * @return true Pokud přenos pořád běží
+ */
+bool isTwiBusy() {
+    if (!twiBusy || millis() - twiStartMillis <= TWI_TIMEOUT_MILLIS) {
+        return twiBusy;
+    }
+    noInterrupts();
+    bool stillBusy = twiBusy;
+    if (stillBusy) {
+        // vypnutá periferie už přerušení nevyvolá, přenos nemůže mezitím doběhnout
+        TWCR = 0;
+    }
+    interrupts();
+    if (stillBusy) {
+        recoverTwi();
+        *twiStatus = TWI_TIMEOUT;
+        twiBusy = false;
+    }
+    return false;
+}
+
+/**
+ * @brief Počká na konec přenosu, mezitím procesor spí v režimu idle
+ * Čekání je omezené na TWI_TIMEOUT_MILLIS, display a tlačítka obsluhuje tick i během něj.
+ *
+ * @return false Pokud přenos vypršel a sběrnice se obnovovala
+ */
+bool waitForTwi() {
+    uint16_t recoveries = twiRecoveries;
+    while (isTwiBusy()) {
+        idle();
+    }
+    return recoveries == twiRecoveries;
+}
+
+/**
+ * @brief Zjistí a smaže, zdali od posledního volání obsluha přerušení dokončila nějaký přenos
+ */
+bool takeTwiCompletion() {
+    noInterrupts();
+    bool completed = twiCompleted;
+    twiCompleted = false;
+    interrupts();
+    return completed;
+}
+
+/**
+ * @brief Počet obnov sběrnice po vypršení přenosu
+ */
+uint16_t getTwiRecoveries() {
+    return twiRecoveries;
+}
+
+/**
+ * @brief Ukončí přenos podmínkou STOP, další přerušení už nepřijde
+ */
+void finishTransfer(uint8_t status) {
+    TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO);
+    *twiStatus = status;
+    twiBusy = false;
+    twiCompleted = true;
+}
+
+/**
+ * @brief Krok přenosu po každé události na sběrnici
+ *
+ */
+ISR(TWI_vect) {
+    switch (TWSR & TWI_STATUS_MASK) {
+        case TWI_START:
+        case TWI_REPEATED_START:
+            // po zápisu adresy registru následuje čtení
+            TWDR = twiIndex < twiWriteLength ? twiAddress : twiAddress | TWI_READ_BIT;
+            TWCR = TWI_CONTROL;
+            break;
+        case TWI_WRITE_ADDRESS_ACK:
+        case TWI_WRITE_DATA_ACK:
+            if (twiIndex < twiWriteLength) {
+                TWDR = twiBuffer[twiIndex++];
+                TWCR = TWI_CONTROL;
+            } else if (twiReadLength > 0) {
+                TWCR = TWI_CONTROL | _BV(TWSTA);
+            } else {
+                finishTransfer(TWI_DONE);
+            }
+            break;
+        case TWI_READ_ADDRESS_ACK:
+            twiIndex = 0;
+            TWCR = twiReadLength > 1 ? TWI_CONTROL | _BV(TWEA) : TWI_CONTROL;
+            break;
+        case TWI_READ_DATA_ACK:
+            twiReadData[twiIndex++] = TWDR;
+            // poslední bajt se nepotvrdí, tím zařízení pozná konec čtení
+            TWCR = twiIndex + 1 < twiReadLength ? TWI_CONTROL | _BV(TWEA) : TWI_CONTROL;
+            break;
+        case TWI_READ_DATA_NACK:
+            twiReadData[twiIndex++] = TWDR;
+            finishTransfer(TWI_DONE);
+            break;
+        case TWI_WRITE_ADDRESS_NACK:
+        case TWI_WRITE_DATA_NACK:
+        case TWI_READ_ADDRESS_NACK:
+            finishTransfer(TWI_NACK);
+            break;
+        default:
+            // chyba sběrnice nebo ztráta arbitráže, STOP periferii uvolní
+            finishTransfer(TWI_BUS_ERROR);
+            break;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef __TWI__HPP__
+#define __TWI__HPP__
+#include <Arduino.h>
+
+/**
+ * Ovladač sběrnice I2C (TWI) řízený přerušením. Přenos se jen spustí a celý ho odbaví obsluha přerušení TWI,
+ * přečtená data a výsledný stav zapíše do proměnných volajícího a ovladač je hned volný pro další přenos.
+ * Najednou běží nejvýše jeden přenos.
+ *
+ * Přenos, který nedoběhne do TWI_TIMEOUT_MILLIS (odpojený modul, zaseknutá linka SDA), se zruší
+ * a sběrnice se obnoví: periferie se vypne, až 9 pulzy SCL se uvolní zařízení, které drží SDA, a pošle se STOP.
+ */
+#define TWI_SDA_PIN A4
+#define TWI_SCL_PIN A5
+#define TWI_FREQUENCY 100000UL
+#ifndef TWI_TIMEOUT_MILLIS
+#define TWI_TIMEOUT_MILLIS 5
+#endif
+#define TWI_RECOVERY_PULSES 9
+#define TWI_RECOVERY_HALF_PERIOD_MICROS 5
+/**
+ * Nejdelší zápis včetně adresy prvního registru, registry alarmů čipu DS3231
+ */
+#define TWI_BUFFER_LENGTH 10
+
+enum TwiStatus {
+    TWI_IDLE,
+    TWI_BUSY,
+    TWI_DONE,
+    TWI_NACK,
+    TWI_BUS_ERROR,
+    TWI_TIMEOUT
+};
+
+void initTwi();
+bool startTwiWrite(uint8_t address, uint8_t firstRegister, const uint8_t* data, uint8_t length,
+                   volatile uint8_t* status);
+bool startTwiRead(uint8_t address, uint8_t firstRegister, volatile uint8_t* data, uint8_t length,
+                  volatile uint8_t* status);
+bool isTwiBusy();
+bool waitForTwi();
+bool takeTwiCompletion();
+uint16_t getTwiRecoveries();
+
+#endif
@@ -0,0 +1,366 @@
+#include "ui.hpp"
+
+#include "display/display.hpp"
+#include "memory/memory.hpp"
+#include "profiler/profiler.hpp"
+#include "temperature/temperature.hpp"
+#include "trace/trace.hpp"
+
+void enterTimeSetting();
+void enterAlarmSetting();
+void confirmTime();
+void confirmAlarm();
+void enterTemperaturePage();
+void quickToggleAlarm();
+void drawClock(Time currentTime);
+void drawTimeHours(Time currentTime);
+void drawTimeMinutes(Time currentTime);
+void drawAlarmHours(Time currentTime);
+void drawAlarmMinutes(Time currentTime);
+void drawSnooze(Time currentTime);
+void drawTemperature(Time currentTime);
+void drawAlarmStatus(Time currentTime);
+
+/**
+ * @brief Tabulka přechodů stavového automatu [stav][událost] ve flash paměti
+ * Řádek stavu nastavení času a nastavení alarmu se liší jen tlačítky potvrzení a přepnutí alarmu,
+ * akce úprav času (incrementHour, ...) jsou pro oba módy společné. Opakování drženého tlačítka dělá
+ * stejnou akci jako kliknutí, rychlé opakování posouvá minuty po 10, dlouhý stisk nastavování zruší.
+ */
+constexpr UiTransition transitions[NUMBER_OF_UI_STATES][NUMBER_OF_UI_EVENTS] PROGMEM = {
+    // UI_CLOCK
+    {{enterTimeSetting, UI_SET_TIME_HOURS},
+     {enterTemperaturePage, UI_TEMPERATURE},
+     {nullptr, UI_CLOCK},
+     {enterAlarmSetting, UI_SET_ALARM_HOURS},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {quickToggleAlarm, UI_ALARM_STATUS}},
+    // UI_SET_TIME_HOURS
+    {{nullptr, UI_SET_TIME_MINUTES},
+     {incrementHour, UI_SET_TIME_HOURS},
+     {decrementHour, UI_SET_TIME_HOURS},
+     {nullptr, UI_SET_TIME_HOURS},
+     {nullptr, UI_SET_TIME_HOURS},
+     {incrementHour, UI_SET_TIME_HOURS},
+     {decrementHour, UI_SET_TIME_HOURS},
+     {incrementHour, UI_SET_TIME_HOURS},
+     {decrementHour, UI_SET_TIME_HOURS},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_SET_TIME_HOURS}},
+    // UI_SET_TIME_MINUTES
+    {{confirmTime, UI_CLOCK},
+     {incrementMinute, UI_SET_TIME_MINUTES},
+     {decrementMinute, UI_SET_TIME_MINUTES},
+     {nullptr, UI_SET_TIME_MINUTES},
+     {nullptr, UI_SET_TIME_MINUTES},
+     {incrementMinute, UI_SET_TIME_MINUTES},
+     {decrementMinute, UI_SET_TIME_MINUTES},
+     {incrementTenMinutes, UI_SET_TIME_MINUTES},
+     {decrementTenMinutes, UI_SET_TIME_MINUTES},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_SET_TIME_MINUTES}},
+    // UI_SET_ALARM_HOURS
+    {{toggleAlarmStatus, UI_SET_ALARM_HOURS},
+     {incrementHour, UI_SET_ALARM_HOURS},
+     {decrementHour, UI_SET_ALARM_HOURS},
+     {nullptr, UI_SET_ALARM_MINUTES},
+     {nullptr, UI_SET_ALARM_HOURS},
+     {incrementHour, UI_SET_ALARM_HOURS},
+     {decrementHour, UI_SET_ALARM_HOURS},
+     {incrementHour, UI_SET_ALARM_HOURS},
+     {decrementHour, UI_SET_ALARM_HOURS},
+     {revertAlarmStatus, UI_CLOCK},
+     {nullptr, UI_SET_ALARM_HOURS}},
+    // UI_SET_ALARM_MINUTES
+    {{toggleAlarmStatus, UI_SET_ALARM_MINUTES},
+     {incrementMinute, UI_SET_ALARM_MINUTES},
+     {decrementMinute, UI_SET_ALARM_MINUTES},
+     {nullptr, UI_SET_SNOOZE},
+     {nullptr, UI_SET_ALARM_MINUTES},
+     {incrementMinute, UI_SET_ALARM_MINUTES},
+     {decrementMinute, UI_SET_ALARM_MINUTES},
+     {incrementTenMinutes, UI_SET_ALARM_MINUTES},
+     {decrementTenMinutes, UI_SET_ALARM_MINUTES},
+     {revertAlarmStatus, UI_CLOCK},
+     {nullptr, UI_SET_ALARM_MINUTES}},
+    // UI_SET_SNOOZE
+    {{nullptr, UI_SET_SNOOZE},
+     {incrementSnoozeMinutes, UI_SET_SNOOZE},
+     {decrementSnoozeMinutes, UI_SET_SNOOZE},
+     {confirmAlarm, UI_CLOCK},
+     {nullptr, UI_SET_SNOOZE},
+     {incrementSnoozeMinutes, UI_SET_SNOOZE},
+     {decrementSnoozeMinutes, UI_SET_SNOOZE},
+     {incrementSnoozeMinutes, UI_SET_SNOOZE},
+     {decrementSnoozeMinutes, UI_SET_SNOOZE},
+     {revertAlarmStatus, UI_CLOCK},
+     {nullptr, UI_SET_SNOOZE}},
+    // UI_TEMPERATURE
+    {{enterTimeSetting, UI_SET_TIME_HOURS},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {enterAlarmSetting, UI_SET_ALARM_HOURS},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_TEMPERATURE},
+     {nullptr, UI_TEMPERATURE},
+     {nullptr, UI_TEMPERATURE},
+     {nullptr, UI_TEMPERATURE},
+     {nullptr, UI_CLOCK},
+     {quickToggleAlarm, UI_ALARM_STATUS}},
+    // UI_ALARM_STATUS
+    {{enterTimeSetting, UI_SET_TIME_HOURS},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {enterAlarmSetting, UI_SET_ALARM_HOURS},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {nullptr, UI_CLOCK},
+     {quickToggleAlarm, UI_ALARM_STATUS}},
+};
+
+/**
+ * @brief Funkce, která vykreslí display v daném stavu, indexováno stavem
+ */
+constexpr UiView views[NUMBER_OF_UI_STATES] PROGMEM = {
+    drawClock,
+    drawTimeHours,
+    drawTimeMinutes,
+    drawAlarmHours,
+    drawAlarmMinutes,
+    drawSnooze,
+    drawTemperature,
+    drawAlarmStatus,
+};
+
+/**
+ * @brief Aktuální stav rozhraní
+ */
+uint8_t uiState = UI_CLOCK;
+
+/**
+ * @brief Kdy se stiskem tlačítka zobrazila stránka teploty nebo stavu alarmu
+ */
+unsigned long pageMillis = 0;
+
+MEMORY_FOOTPRINT(ui, sizeof(uiState) + sizeof(pageMillis));
+
+/**
+ * @brief Zpracuje jednu událost, přechod se najde přímo indexem do tabulky přechodů
+ * Zvonící nebo odložený alarm tlačítko SNOOZE odloží a kterékoliv jiné tlačítko vypne, událost se pak dál nezpracuje.
+ * 
+ * @param event Událost z UiEvents
+ */
+void handleUiEvent(uint8_t event) {
+    if (event >= NUMBER_OF_UI_EVENTS) {
+        return;
+    }
+    if (isAlarmRinging() || isAlarmSnoozed()) {
+        if (event == UI_EVENT_SNOOZE) {
+            snoozeAlarm();
+        } else {
+            turnOffAlarm();
+        }
+        return;
+    }
+    const UiTransition* transition = &transitions[uiState][event];
+    UiAction action = (UiAction)pgm_read_ptr(&transition->action);
+    uint8_t previousState = uiState;
+    uiState = pgm_read_byte(&transition->nextState);
+    if (uiState != previousState) {
+        traceEvent(TRACE_UI, previousState, uiState, event);
+    }
+    if (action != nullptr) {
+        action();
+    }
+}
+
+/**
+ * @brief Vykreslí display podle aktuálního stavu rozhraní
+ * 
+ * @param currentTime Aktuální čas hodin
+ */
+void redrawUi(Time currentTime) {
+    PROFILE_SCOPE(PROFILE_UI_REDRAW);
+    UiView view = (UiView)pgm_read_ptr(&views[uiState]);
+    view(currentTime);
+}
+
+/**
+ * @brief Vrátí aktuální stav rozhraní
+ * @return Stav z UiStates
+ */
+uint8_t getUiState() {
+    return uiState;
+}
+
+/**
+ * @brief Akce při vstupu do nastavení času
+ */
+void enterTimeSetting() {
+    prepareSettingsTime(false);
+}
+
+/**
+ * @brief Akce při vstupu do nastavení alarmu
+ */
+void enterAlarmSetting() {
+    prepareSettingsTime(true);
+}
+
+/**
+ * @brief Akce při potvrzení nastaveného času, zapíše ho do čipu reálného času
+ */
+void confirmTime() {
+    setTime(getSettingsTime());
+}
+
+/**
+ * @brief Akce při potvrzení nastaveného alarmu, nastavení se uloží do EEPROM
+ */
+void confirmAlarm() {
+    setAlarmTime(getSettingsTime());
+    setSnoozeMinutes(getSettingsSnoozeMinutes());
+    commitAlarmSettings();
+}
+
+/**
+ * @brief Akce při stisku TIME+ v režimu hodin, na chvíli zobrazí teplotu
+ */
+void enterTemperaturePage() {
+    pageMillis = millis();
+}
+
+/**
+ * @brief Akce akordu TIME_SET a ALARM_SET, zapne nebo vypne alarm a uloží to do EEPROM bez vstupu do nastavení
+ */
+void quickToggleAlarm() {
+    toggleAlarmStatus();
+    commitAlarmSettings();
+    pageMillis = millis();
+}
+
+/**
+ * @brief Vrátí rozhraní k času, když stránka svítí déle než zadanou dobu
+ * 
+ * @return true Pokud se rozhraní vrátilo k času a display už je vykreslený
+ */
+bool closeExpiredPage(Time currentTime, uint16_t pageDuration) {
+    if (millis() - pageMillis < pageDuration) {
+        return false;
+    }
+    traceEvent(TRACE_UI, uiState, UI_CLOCK, TRACE_UI_TIMEOUT);
+    uiState = UI_CLOCK;
+    drawClock(currentTime);
+    return true;
+}
+
+/**
+ * @brief Zobrazí uloženou teplotu bez dvojtečky, dokud se teplota nepřečetla, zobrazí pomlčky
+ */
+void showTemperaturePage(Time currentTime) {
+    turnOffDots();
+    setBrightness(brightnessForTime(currentTime));
+    if (hasTemperature()) {
+        showTemperature(getTemperatureQuarters());
+    } else {
+        showFlashText(PSTR("--*C"));
+    }
+}
+
+/**
+ * @brief Zobrazí čas při normálním běhu hodin, odložené buzení ukazuje tečka za poslední číslicí
+ * a nedostatek paměti zjištěný s build flagem MEMORY_WATCH tečka za první číslicí
+ * S build flagem TEMPERATURE_PAGE se v TEMPERATURE_PAGE_SECOND každé minuty na chvíli zobrazí teplota.
+ */
+void drawClock(Time currentTime) {
+#ifdef TEMPERATURE_PAGE
+    uint8_t pageSecond = currentTime.seconds - TEMPERATURE_PAGE_SECOND;
+    if (hasTemperature() && pageSecond < TEMPERATURE_PAGE_SECONDS) {
+        showTemperaturePage(currentTime);
+        return;
+    }
+#endif
+    blinkWithDots(currentTime.seconds);
+    setBrightness(brightnessForTime(currentTime));
+    showTimeDigits(getTimeDigits());
+    setDigitDot(0, isMemoryLow());
+    setDigitDot(NUMBER_OF_DIGITS - 1, isAlarmSnoozed());
+}
+
+/**
+ * @brief Zobrazí nastavovaný čas s blikajícími hodinami
+ */
+void drawTimeHours(Time currentTime) {
+    turnOffDots();
+    showBlinkingHours(currentTime, getSettingsTime());
+}
+
+/**
+ * @brief Zobrazí nastavovaný čas s blikajícími minutami
+ */
+void drawTimeMinutes(Time currentTime) {
+    turnOffDots();
+    showBlinkingMinutes(currentTime, getSettingsTime());
+}
+
+/**
+ * @brief Zobrazí čas buzení s blikajícími hodinami, vypnutý alarm se ukáže pomlčkami
+ */
+void drawAlarmHours(Time currentTime) {
+    turnOffDots();
+    if (getAlarmSettings().on) {
+        showBlinkingHours(currentTime, getSettingsTime());
+    } else {
+        showBlinkingDashes(currentTime, true);
+    }
+}
+
+/**
+ * @brief Zobrazí čas buzení s blikajícími minutami, vypnutý alarm se ukáže pomlčkami
+ */
+void drawAlarmMinutes(Time currentTime) {
+    turnOffDots();
+    if (getAlarmSettings().on) {
+        showBlinkingMinutes(currentTime, getSettingsTime());
+    } else {
+        showBlinkingDashes(currentTime, false);
+    }
+}
+
+/**
+ * @brief Zobrazí délku odkladu buzení s blikajícím počtem minut
+ */
+void drawSnooze(Time currentTime) {
+    turnOffDots();
+    showBlinkingSnooze(currentTime, getSettingsSnoozeMinutes());
+}
+
+/**
+ * @brief Zobrazí teplotu, po TEMPERATURE_PAGE_MILLIS se rozhraní samo vrátí k času
+ */
+void drawTemperature(Time currentTime) {
+    if (closeExpiredPage(currentTime, TEMPERATURE_PAGE_MILLIS)) {
+        return;
+    }
+    showTemperaturePage(currentTime);
+}
+
+/**
+ * @brief Zobrazí, zdali je alarm zapnutý, po ALARM_STATUS_PAGE_MILLIS se rozhraní samo vrátí k času
+ */
+void drawAlarmStatus(Time currentTime) {
+    if (closeExpiredPage(currentTime, ALARM_STATUS_PAGE_MILLIS)) {
+        return;
+    }
+    turnOffDots();
+    setBrightness(brightnessForTime(currentTime));
+    showFlashText(getAlarmSettings().on ? PSTR("  on") : PSTR(" oFF"));
+}
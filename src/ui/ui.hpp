@@ -0,0 +1,80 @@
+#ifndef __UI__HPP__
+#define __UI__HPP__
+#include <Arduino.h>
+
+#include "buttons/buttonHandler.hpp"
+#include "buttons/gestures.hpp"
+#include "time/time.hpp"
+
+/**
+ * Stavy uživatelského rozhraní hodin
+ * UI_CLOCK - hodiny ukazují čas
+ * UI_SET_TIME_HOURS, UI_SET_TIME_MINUTES - nastavování hodin a minut času
+ * UI_SET_ALARM_HOURS, UI_SET_ALARM_MINUTES - nastavování hodin a minut buzení
+ * UI_SET_SNOOZE - nastavování délky odkladu buzení
+ * UI_TEMPERATURE - hodiny na chvíli ukazují teplotu
+ * UI_ALARM_STATUS - hodiny na chvíli ukazují, zdali akord alarm zapnul nebo vypnul
+ */
+enum UiStates {
+    UI_CLOCK,
+    UI_SET_TIME_HOURS,
+    UI_SET_TIME_MINUTES,
+    UI_SET_ALARM_HOURS,
+    UI_SET_ALARM_MINUTES,
+    UI_SET_SNOOZE,
+    UI_TEMPERATURE,
+    UI_ALARM_STATUS,
+    NUMBER_OF_UI_STATES
+};
+
+/**
+ * Stránka teploty se po stisku TIME+ zobrazí na TEMPERATURE_PAGE_MILLIS. S build flagem TEMPERATURE_PAGE
+ * se navíc střídá s časem: od sekundy TEMPERATURE_PAGE_SECOND každé minuty ukazuje teplotu TEMPERATURE_PAGE_SECONDS sekund.
+ * Stav alarmu po akordu se zobrazí na ALARM_STATUS_PAGE_MILLIS.
+ */
+#define TEMPERATURE_PAGE_MILLIS 3000
+#define ALARM_STATUS_PAGE_MILLIS 1500
+#ifndef TEMPERATURE_PAGE_SECOND
+#define TEMPERATURE_PAGE_SECOND 30
+#endif
+#ifndef TEMPERATURE_PAGE_SECONDS
+#define TEMPERATURE_PAGE_SECONDS 3
+#endif
+
+/**
+ * Události uživatelského rozhraní jsou gesta tlačítek, kliknutí tlačítka má stejný index jako tlačítko v Buttons
+ * UI_EVENT_*_REPEAT, UI_EVENT_*_FAST - opakování drženého TIME+ a TIME-, rychlé opakování skáče po 10 minutách
+ * UI_EVENT_LONG_PRESS - dlouhý stisk TIME_SET nebo ALARM_SET, zruší nastavování bez uložení
+ * UI_EVENT_CHORD - TIME_SET a ALARM_SET zároveň, rychle zapne nebo vypne alarm
+ */
+enum UiEvents {
+    UI_EVENT_TIME_SET = BUTTON_TIME_SET,
+    UI_EVENT_TIME_PLUS = BUTTON_TIME_PLUS,
+    UI_EVENT_TIME_MINUS = BUTTON_TIME_MINUS,
+    UI_EVENT_ALARM_SET = BUTTON_ALARM_SET,
+    UI_EVENT_SNOOZE = BUTTON_SNOOZE,
+    UI_EVENT_PLUS_REPEAT = GESTURE_PLUS_REPEAT,
+    UI_EVENT_MINUS_REPEAT = GESTURE_MINUS_REPEAT,
+    UI_EVENT_PLUS_FAST = GESTURE_PLUS_FAST,
+    UI_EVENT_MINUS_FAST = GESTURE_MINUS_FAST,
+    UI_EVENT_LONG_PRESS = GESTURE_LONG_PRESS,
+    UI_EVENT_CHORD = GESTURE_CHORD,
+    NUMBER_OF_UI_EVENTS
+};
+
+typedef void (*UiAction)();
+typedef void (*UiView)(Time currentTime);
+
+/**
+ * Přechod stavového automatu: akce, která se provede, a stav, do kterého rozhraní přejde
+ */
+struct UiTransition {
+    UiAction action;
+    uint8_t nextState;
+};
+
+void handleUiEvent(uint8_t event);
+void redrawUi(Time currentTime);
+uint8_t getUiState();
+
+#endif
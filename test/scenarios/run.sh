@@ -0,0 +1,22 @@
+#!/bin/sh
+# Spustí všechny scénáře simulátoru a porovná kód ukončení s řádkem "# exit" ve scénáři.
+# Parametry simulátoru bere z řádku "# args", program simulátoru je první parametr skriptu.
+#
+# pio run -e native && test/scenarios/run.sh .pio/build/native/program
+
+program=${1:-.pio/build/native/program}
+directory=$(dirname "$0")
+failed=0
+for scenario in "$directory"/*.txt; do
+    args=$(sed -n 's/^# args //p' "$scenario")
+    expected=$(sed -n 's/^# exit //p' "$scenario")
+    "$program" $args --script "$scenario" > /dev/null
+    status=$?
+    if [ "$status" -eq "${expected:-0}" ]; then
+        echo "ok   $scenario"
+    else
+        echo "FAIL $scenario: exit $status, expected ${expected:-0}"
+        failed=1
+    fi
+done
+exit $failed
@@ -0,0 +1,47 @@
+#include <unity.h>
+
+#include "time/rtc.hpp"
+
+void setUp() {}
+void tearDown() {}
+
+void test_bcd_to_binary() {
+    TEST_ASSERT_EQUAL_UINT8(0, bcdToBinary(0x00));
+    TEST_ASSERT_EQUAL_UINT8(9, bcdToBinary(0x09));
+    TEST_ASSERT_EQUAL_UINT8(10, bcdToBinary(0x10));
+    TEST_ASSERT_EQUAL_UINT8(23, bcdToBinary(0x23));
+    TEST_ASSERT_EQUAL_UINT8(59, bcdToBinary(0x59));
+    TEST_ASSERT_EQUAL_UINT8(99, bcdToBinary(0x99));
+}
+
+void test_binary_to_bcd() {
+    TEST_ASSERT_EQUAL_HEX8(0x00, binaryToBcd(0));
+    TEST_ASSERT_EQUAL_HEX8(0x09, binaryToBcd(9));
+    TEST_ASSERT_EQUAL_HEX8(0x10, binaryToBcd(10));
+    TEST_ASSERT_EQUAL_HEX8(0x23, binaryToBcd(23));
+    TEST_ASSERT_EQUAL_HEX8(0x59, binaryToBcd(59));
+    TEST_ASSERT_EQUAL_HEX8(0x99, binaryToBcd(99));
+}
+
+void test_round_trip() {
+    for (uint8_t value = 0; value <= 99; value++) {
+        TEST_ASSERT_EQUAL_UINT8(value, bcdToBinary(binaryToBcd(value)));
+    }
+}
+
+/**
+ * @brief Hodiny ve 24 hodinovém módu čip ukládá v BCD s nulovými horními bity
+ */
+void test_hours_register() {
+    TEST_ASSERT_EQUAL_UINT8(21, bcdToBinary(0x21 & DS3231_HOURS_MASK));
+    TEST_ASSERT_EQUAL_UINT8(11, bcdToBinary(0x71 & DS3231_12_HOURS_MASK));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bcd_to_binary);
+    RUN_TEST(test_binary_to_bcd);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_hours_register);
+    return UNITY_END();
+}
@@ -0,0 +1,58 @@
+#include <string.h>
+#include <unity.h>
+
+#include "crc/crc.hpp"
+
+void setUp() {}
+void tearDown() {}
+
+/**
+ * @brief Kontrolní hodnota CRC-8 s polynomem 0x31 a nulovou počáteční hodnotou pro "123456789"
+ */
+void test_check_value() {
+    const char* text = "123456789";
+    TEST_ASSERT_EQUAL_HEX8(0xA2, crc8((const uint8_t*)text, strlen(text)));
+}
+
+void test_empty_block_is_zero() {
+    TEST_ASSERT_EQUAL_HEX8(0x00, crc8(nullptr, 0));
+}
+
+void test_update_matches_block() {
+    const uint8_t data[] = {0x03, 0x01, 0x0C, 0x05, 0x01};
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        crc = crc8Update(crc, data[i]);
+    }
+    TEST_ASSERT_EQUAL_HEX8(crc8(data, sizeof(data)), crc);
+}
+
+/**
+ * @brief Blok i s připojeným CRC má CRC nulové, podle toho se pozná nepoškozený rámec nebo záznam
+ */
+void test_block_with_crc_gives_zero() {
+    uint8_t data[] = {0x00, 0x02, 0x00};
+    data[2] = crc8(data, 2);
+    TEST_ASSERT_EQUAL_HEX8(0x62, data[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, crc8(data, sizeof(data)));
+}
+
+void test_single_bit_error_is_detected() {
+    uint8_t data[] = {0x12, 0x34, 0x56, 0x78};
+    uint8_t crc = crc8(data, sizeof(data));
+    for (uint8_t bit = 0; bit < 8 * sizeof(data); bit++) {
+        data[bit / 8] ^= 1 << (bit % 8);
+        TEST_ASSERT_TRUE(crc8(data, sizeof(data)) != crc);
+        data[bit / 8] ^= 1 << (bit % 8);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_check_value);
+    RUN_TEST(test_empty_block_is_zero);
+    RUN_TEST(test_update_matches_block);
+    RUN_TEST(test_block_with_crc_gives_zero);
+    RUN_TEST(test_single_bit_error_is_detected);
+    return UNITY_END();
+}
@@ -0,0 +1,137 @@
+#include <unity.h>
+
+#include "buttons/eventQueue.hpp"
+#include "buttons/gestures.hpp"
+#include "sim/sim.hpp"
+
+#define NO_GESTURE 0xFF
+
+void press(uint8_t button) {
+    pushButtonEvent(button);
+}
+
+void release(uint8_t button) {
+    pushButtonEvent(button | BUTTON_EVENT_RELEASED);
+}
+
+/**
+ * @brief Vrátí další gesto, nebo NO_GESTURE
+ */
+uint8_t nextGesture() {
+    uint8_t gesture;
+    return popGesture(&gesture) ? gesture : NO_GESTURE;
+}
+
+/**
+ * @brief Posune virtuální čas a vrátí první gesto, které při tom vzniklo, jako úloha tlačítek každých 10 ms
+ */
+uint8_t gestureWithin(uint32_t millis) {
+    for (uint32_t elapsed = 0; elapsed < millis; elapsed += 10) {
+        simAdvance(10000);
+        uint8_t gesture = nextGesture();
+        if (gesture != NO_GESTURE) {
+            return gesture;
+        }
+    }
+    return NO_GESTURE;
+}
+
+void setUp() {}
+
+/**
+ * @brief Po každém testu jsou všechna tlačítka puštěná
+ */
+void tearDown() {
+    while (nextGesture() != NO_GESTURE) {
+    }
+}
+
+void test_plus_clicks_on_press() {
+    press(BUTTON_TIME_PLUS);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_TIME_PLUS, nextGesture());
+    release(BUTTON_TIME_PLUS);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, nextGesture());
+}
+
+void test_set_clicks_on_release() {
+    press(BUTTON_TIME_SET);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, nextGesture());
+    release(BUTTON_TIME_SET);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_TIME_SET, nextGesture());
+}
+
+void test_long_press_does_not_click() {
+    press(BUTTON_ALARM_SET);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, gestureWithin(LONG_PRESS_MILLIS - 20));
+    TEST_ASSERT_EQUAL_UINT8(GESTURE_LONG_PRESS, gestureWithin(40));
+    release(BUTTON_ALARM_SET);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, nextGesture());
+}
+
+void test_repeat_turns_fast() {
+    press(BUTTON_TIME_MINUS);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_TIME_MINUS, nextGesture());
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, gestureWithin(REPEAT_DELAY_MILLIS - 20));
+    TEST_ASSERT_EQUAL_UINT8(GESTURE_MINUS_REPEAT, gestureWithin(40));
+    for (uint8_t i = 1; i < REPEATS_BEFORE_FAST; i++) {
+        TEST_ASSERT_EQUAL_UINT8(GESTURE_MINUS_REPEAT, gestureWithin(REPEAT_PERIOD_MILLIS + 10));
+    }
+    TEST_ASSERT_EQUAL_UINT8(GESTURE_MINUS_FAST, gestureWithin(REPEAT_PERIOD_MILLIS + 10));
+    release(BUTTON_TIME_MINUS);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, gestureWithin(1000));
+}
+
+void test_chord_does_not_click() {
+    press(BUTTON_TIME_SET);
+    press(BUTTON_ALARM_SET);
+    TEST_ASSERT_EQUAL_UINT8(GESTURE_CHORD, nextGesture());
+    release(BUTTON_TIME_SET);
+    release(BUTTON_ALARM_SET);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, gestureWithin(LONG_PRESS_MILLIS + 100));
+}
+
+/**
+ * @brief Krátké ťuknutí na TIME- během opakování TIME+ opakování nezastaví
+ */
+void test_repeat_resumes_after_other_button() {
+    press(BUTTON_TIME_PLUS);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_TIME_PLUS, nextGesture());
+    TEST_ASSERT_EQUAL_UINT8(GESTURE_PLUS_REPEAT, gestureWithin(REPEAT_DELAY_MILLIS + 10));
+    press(BUTTON_TIME_MINUS);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_TIME_MINUS, nextGesture());
+    simAdvance(100000);
+    release(BUTTON_TIME_MINUS);
+    TEST_ASSERT_EQUAL_UINT8(GESTURE_PLUS_REPEAT, gestureWithin(REPEAT_DELAY_MILLIS + 10));
+    release(BUTTON_TIME_PLUS);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, gestureWithin(1000));
+}
+
+/**
+ * @brief Stisk TIME+ během držení ALARM_SET zruší dlouhý stisk i kliknutí při puštění ALARM_SET
+ */
+void test_second_press_cancels_long_press() {
+    press(BUTTON_ALARM_SET);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, gestureWithin(300));
+    press(BUTTON_TIME_PLUS);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_TIME_PLUS, nextGesture());
+    release(BUTTON_TIME_PLUS);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, gestureWithin(LONG_PRESS_MILLIS));
+    release(BUTTON_ALARM_SET);
+    TEST_ASSERT_EQUAL_UINT8(NO_GESTURE, nextGesture());
+    // další stisk už klikne normálně
+    press(BUTTON_ALARM_SET);
+    release(BUTTON_ALARM_SET);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_ALARM_SET, nextGesture());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_plus_clicks_on_press);
+    RUN_TEST(test_set_clicks_on_release);
+    RUN_TEST(test_long_press_does_not_click);
+    RUN_TEST(test_repeat_turns_fast);
+    RUN_TEST(test_chord_does_not_click);
+    RUN_TEST(test_repeat_resumes_after_other_button);
+    RUN_TEST(test_second_press_cancels_long_press);
+    return UNITY_END();
+}
@@ -0,0 +1,96 @@
+#include <unity.h>
+
+#include "crc/crc.hpp"
+#include "protocol/protocol.hpp"
+
+/**
+ * @brief Parser rámců a počítadlo chybných rámců z protocol.cpp, v hlavičce nejsou
+ */
+bool parseByte(uint8_t data);
+extern uint8_t frame[];
+extern uint16_t badFrames;
+
+/**
+ * @brief Pošle parseru bajty a vrátí, po kolikátém bajtu byl rámec celý, 0 pokud nebyl
+ */
+uint8_t feed(const uint8_t* data, uint8_t length) {
+    for (uint8_t i = 0; i < length; i++) {
+        if (parseByte(data[i])) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_frame_without_payload() {
+    uint8_t data[] = {PROTOCOL_START_BYTE, 0x00, PROTOCOL_GET_TIME, 0x00};
+    data[3] = crc8(&data[1], 2);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(data), feed(data, sizeof(data)));
+}
+
+void test_frame_with_payload() {
+    uint8_t data[] = {PROTOCOL_START_BYTE, 0x03, PROTOCOL_SET_ALARM, 0x06, 0x1E, 0x01, 0x00};
+    data[6] = crc8(&data[1], 5);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(data), feed(data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT8(PROTOCOL_SET_ALARM, frame[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x06, frame[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x1E, frame[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, frame[5]);
+}
+
+void test_bytes_before_start_are_skipped() {
+    uint8_t data[] = {0x00, 0x55, 0xFF, PROTOCOL_START_BYTE, 0x00, PROTOCOL_GET_ALARM, 0x00};
+    data[6] = crc8(&data[4], 2);
+    uint16_t bad = badFrames;
+    TEST_ASSERT_EQUAL_UINT8(sizeof(data), feed(data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT16(bad, badFrames);
+}
+
+void test_wrong_crc_drops_frame() {
+    uint8_t data[] = {PROTOCOL_START_BYTE, 0x00, PROTOCOL_GET_TIME, 0x00};
+    data[3] = crc8(&data[1], 2) ^ 0x01;
+    uint16_t bad = badFrames;
+    TEST_ASSERT_EQUAL_UINT8(0, feed(data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT16(bad + 1, badFrames);
+}
+
+void test_too_long_payload_drops_frame() {
+    uint8_t data[] = {PROTOCOL_START_BYTE, PROTOCOL_MAX_PAYLOAD + 1};
+    uint16_t bad = badFrames;
+    TEST_ASSERT_EQUAL_UINT8(0, feed(data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT16(bad + 1, badFrames);
+}
+
+/**
+ * @brief Po zahozeném rámci parser čeká na další začátek rámce a ten přijme
+ */
+void test_next_frame_after_error() {
+    uint8_t broken[] = {PROTOCOL_START_BYTE, 0x00, PROTOCOL_GET_TIME, 0x00};
+    broken[3] = crc8(&broken[1], 2) ^ 0xFF;
+    TEST_ASSERT_EQUAL_UINT8(0, feed(broken, sizeof(broken)));
+    uint8_t data[] = {PROTOCOL_START_BYTE, 0x01, PROTOCOL_GET_FOOTPRINT, 0x02, 0x00};
+    data[4] = crc8(&data[1], 3);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(data), feed(data, sizeof(data)));
+}
+
+void test_longest_frame() {
+    uint8_t data[PROTOCOL_MAX_PAYLOAD + PROTOCOL_FRAME_OVERHEAD] = {PROTOCOL_START_BYTE, PROTOCOL_MAX_PAYLOAD,
+                                                                   PROTOCOL_SET_CONFIG};
+    data[sizeof(data) - 1] = crc8(&data[1], PROTOCOL_MAX_PAYLOAD + 2);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(data), feed(data, sizeof(data)));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_without_payload);
+    RUN_TEST(test_frame_with_payload);
+    RUN_TEST(test_bytes_before_start_are_skipped);
+    RUN_TEST(test_wrong_crc_drops_frame);
+    RUN_TEST(test_too_long_payload_drops_frame);
+    RUN_TEST(test_next_frame_after_error);
+    RUN_TEST(test_longest_frame);
+    return UNITY_END();
+}
@@ -0,0 +1,107 @@
+#include <string.h>
+#include <unity.h>
+
+#include "scheduler/scheduler.hpp"
+#include "sim/sim.hpp"
+
+/**
+ * @brief Pořadí, ve kterém úlohy běžely, každá úloha připíše své písmeno
+ */
+char runLog[32];
+uint8_t runLength = 0;
+
+void logRun(char task) {
+    if (runLength < sizeof(runLog) - 1) {
+        runLog[runLength++] = task;
+        runLog[runLength] = '\0';
+    }
+}
+
+void taskA() {
+    logRun('a');
+}
+
+void taskB() {
+    logRun('b');
+}
+
+void taskC() {
+    logRun('c');
+}
+
+void setUp() {
+    runLength = 0;
+    runLog[0] = '\0';
+}
+
+void tearDown() {}
+
+/**
+ * @brief Úlohy plánovače se přidávají jen jednou, testy proto navazují ve virtuálním čase simulátoru
+ */
+uint8_t firstTask;
+uint8_t secondTask;
+uint8_t slowTask;
+
+void test_new_tasks_run_at_once_in_order_added() {
+    firstTask = addTask(taskA, 10);
+    secondTask = addTask(taskB, 10);
+    slowTask = addTask(taskC, 50);
+    TEST_ASSERT_EQUAL_UINT8(0, firstTask);
+    TEST_ASSERT_EQUAL_UINT8(3, getNumberOfTasks());
+    runTasks();
+    TEST_ASSERT_EQUAL_STRING("abc", runLog);
+}
+
+void test_tasks_wait_for_their_period() {
+    TEST_ASSERT_EQUAL(10, millisUntilNextTask());
+    simAdvance(9000);
+    runTasks();
+    TEST_ASSERT_EQUAL_STRING("", runLog);
+    TEST_ASSERT_EQUAL(1, millisUntilNextTask());
+    simAdvance(1000);
+    runTasks();
+    TEST_ASSERT_EQUAL_STRING("ab", runLog);
+}
+
+void test_run_task_now() {
+    runTaskNow(slowTask);
+    TEST_ASSERT_EQUAL(0, millisUntilNextTask());
+    runTasks();
+    TEST_ASSERT_EQUAL_STRING("c", runLog);
+}
+
+/**
+ * @brief Úloha zpožděná o celou periodu zmešká termín a zmeškané běhy nedohání
+ */
+void test_missed_deadline() {
+    takeTaskStats(firstTask);
+    simAdvance(25000);
+    runTasks();
+    runTasks();
+    TEST_ASSERT_EQUAL_STRING("ab", runLog);
+    Task stats = takeTaskStats(firstTask);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.missedDeadlines);
+    TEST_ASSERT_EQUAL_UINT16(15, stats.maxLatenessMillis);
+    TEST_ASSERT_EQUAL(10, millisUntilNextTask());
+    stats = takeTaskStats(firstTask);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.missedDeadlines);
+}
+
+void test_full_table_rejects_task() {
+    while (getNumberOfTasks() < MAX_TASKS) {
+        TEST_ASSERT_EQUAL_UINT8(getNumberOfTasks(), addTask(taskA, 1000));
+    }
+    TEST_ASSERT_EQUAL_UINT8(MAX_TASKS, addTask(taskA, 1000));
+    TEST_ASSERT_EQUAL_UINT8(MAX_TASKS, getNumberOfTasks());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_new_tasks_run_at_once_in_order_added);
+    RUN_TEST(test_tasks_wait_for_their_period);
+    RUN_TEST(test_run_task_now);
+    RUN_TEST(test_missed_deadline);
+    RUN_TEST(test_full_table_rejects_task);
+    return UNITY_END();
+}
@@ -0,0 +1,124 @@
+#include <EEPROM.h>
+#include <unity.h>
+
+#include "crc/crc.hpp"
+#include "settings/settings.hpp"
+
+/**
+ * @brief Každý test začíná s vymazanou EEPROM
+ */
+void setUp() {
+    for (uint16_t address = 0; address <= E2END; address++) {
+        EEPROM.write(address, 0xFF);
+    }
+}
+
+void tearDown() {}
+
+/**
+ * @brief Zapíše do slotu platný záznam s daným pořadovým číslem a hodinou buzení
+ */
+void writeRecord(uint8_t slot, uint16_t sequence, uint8_t hours) {
+    SettingsRecord record = {};
+    record.sequence = sequence;
+    record.version = SETTINGS_VERSION;
+    record.alarmHours = hours;
+    record.alarmMins = 30;
+    record.alarmOn = true;
+    record.snoozeMinutes = DEFAULT_SNOOZE_MINUTES;
+    record.crc = crc8((const uint8_t*)&record, SETTINGS_RECORD_SIZE - 1);
+    const uint8_t* bytes = (const uint8_t*)&record;
+    for (uint8_t i = 0; i < SETTINGS_RECORD_SIZE; i++) {
+        EEPROM.write(slot * SETTINGS_RECORD_SIZE + i, bytes[i]);
+    }
+}
+
+uint16_t readSequence(uint8_t slot) {
+    uint16_t address = slot * SETTINGS_RECORD_SIZE;
+    return EEPROM.read(address) | EEPROM.read(address + 1) << 8;
+}
+
+void finishWrite() {
+    while (isSettingsWritePending()) {
+        serviceSettings();
+    }
+}
+
+void test_empty_eeprom_has_no_settings() {
+    AlarmSettings settings;
+    TEST_ASSERT_FALSE(loadSettings(&settings));
+}
+
+void test_newest_record_wins() {
+    writeRecord(3, 7, 5);
+    writeRecord(4, 8, 6);
+    writeRecord(10, 2, 7);
+    AlarmSettings settings;
+    TEST_ASSERT_TRUE(loadSettings(&settings));
+    TEST_ASSERT_EQUAL_UINT8(6, settings.ringTime.hours);
+    TEST_ASSERT_EQUAL_UINT8(30, settings.ringTime.mins);
+    TEST_ASSERT_TRUE(settings.on);
+}
+
+/**
+ * @brief Po přetečení pořadového čísla je záznam s číslem 0 novější než záznam s číslem 0xFFFF
+ */
+void test_sequence_wraparound() {
+    writeRecord(20, 0xFFFE, 4);
+    writeRecord(21, 0xFFFF, 5);
+    writeRecord(22, 0x0000, 6);
+    AlarmSettings settings;
+    TEST_ASSERT_TRUE(loadSettings(&settings));
+    TEST_ASSERT_EQUAL_UINT8(6, settings.ringTime.hours);
+}
+
+void test_corrupted_record_is_skipped() {
+    writeRecord(1, 1, 5);
+    writeRecord(2, 2, 6);
+    EEPROM.write(2 * SETTINGS_RECORD_SIZE + 3, 7);  // hodina bez nového CRC
+    AlarmSettings settings;
+    TEST_ASSERT_TRUE(loadSettings(&settings));
+    TEST_ASSERT_EQUAL_UINT8(5, settings.ringTime.hours);
+}
+
+/**
+ * @brief Nový záznam jde do slotu za nejnovějším, z posledního slotu zpátky do slotu 0 s dalším pořadovým číslem
+ */
+void test_save_goes_to_next_slot() {
+    writeRecord(SETTINGS_SLOTS - 1, 0xFFFF, 5);
+    AlarmSettings settings;
+    TEST_ASSERT_TRUE(loadSettings(&settings));
+    settings.ringTime.hours = 8;
+    saveSettings(settings);
+    finishWrite();
+    TEST_ASSERT_EQUAL_UINT16(0x0000, readSequence(0));
+    settings.ringTime.hours = 9;
+    saveSettings(settings);
+    finishWrite();
+    TEST_ASSERT_EQUAL_UINT16(0x0001, readSequence(1));
+
+    AlarmSettings loaded;
+    TEST_ASSERT_TRUE(loadSettings(&loaded));
+    TEST_ASSERT_EQUAL_UINT8(9, loaded.ringTime.hours);
+    TEST_ASSERT_EQUAL_UINT8(DEFAULT_SNOOZE_MINUTES, loaded.snoozeMinutes);
+}
+
+void test_same_settings_are_not_written() {
+    writeRecord(5, 5, 5);
+    AlarmSettings settings;
+    TEST_ASSERT_TRUE(loadSettings(&settings));
+    saveSettings(settings);
+    TEST_ASSERT_FALSE(isSettingsWritePending());
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, readSequence(6));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_eeprom_has_no_settings);
+    RUN_TEST(test_newest_record_wins);
+    RUN_TEST(test_sequence_wraparound);
+    RUN_TEST(test_corrupted_record_is_skipped);
+    RUN_TEST(test_save_goes_to_next_slot);
+    RUN_TEST(test_same_settings_are_not_written);
+    return UNITY_END();
+}
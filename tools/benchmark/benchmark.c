@@ -0,0 +1,191 @@
+/*
+ * Spustí program hodin přeložený s build flagem BENCHMARK (src/benchmark/benchmark.cpp) v simulátoru simavr
+ * a vypíše počty cyklů jednotlivých měření jako JSON.
+ *
+ *     benchmark [-o výstup.json] firmware.elf
+ *
+ * Program ohlašuje měření po sériové lince řádky "B název" a opakování ohraničuje zápisy do GPIOR0,
+ * simulátor si při nich zapíše aktuální cyklus procesoru. Od každého měření se odečte nejkratší
+ * prázdné volání "empty", výsledek je tak počet cyklů samotné funkce.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <simavr/avr_ioport.h>
+#include <simavr/avr_uart.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+
+#include "ds3231.h"
+
+#define MCU "atmega328p"
+#define FREQUENCY 16000000
+#define GPIOR0_ADDRESS 0x3E
+#define BENCHMARK_START 0x01
+#define BENCHMARK_STOP 0x02
+#define BENCHMARK_DONE 0x03
+#define BASELINE_NAME "empty"
+#define MAX_BENCHMARKS 32
+#define MAX_NAME 32
+#define MAX_LINE 64
+/* Pojistka proti zaseknutému programu, 60 s simulovaného času */
+#define MAX_CYCLES (60ULL * FREQUENCY)
+
+typedef struct {
+    char name[MAX_NAME];
+    unsigned long iterations;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+} benchmark_t;
+
+static benchmark_t benchmarks[MAX_BENCHMARKS];
+static int number_of_benchmarks = 0;
+static benchmark_t* current = NULL;
+static uint64_t start_cycle = 0;
+static int running = 0;
+static int done = 0;
+static unsigned long frame_cycles = 0;
+static char line[MAX_LINE];
+static size_t line_length = 0;
+
+/* Zpracuje řádek ze sériové linky: "F cykly", "B název" nebo "E" */
+static void handle_line(const char* text) {
+    if (text[0] == 'F' && text[1] == ' ') {
+        frame_cycles = strtoul(text + 2, NULL, 10);
+    } else if (text[0] == 'B' && text[1] == ' ' && number_of_benchmarks < MAX_BENCHMARKS) {
+        current = &benchmarks[number_of_benchmarks++];
+        memset(current, 0, sizeof(*current));
+        snprintf(current->name, sizeof(current->name), "%s", text + 2);
+        current->min = UINT64_MAX;
+    }
+}
+
+static void uart_output(avr_irq_t* irq, uint32_t value, void* param) {
+    (void)irq;
+    (void)param;
+    if (value == '\r') {
+        return;
+    }
+    if (value == '\n' || line_length == MAX_LINE - 1) {
+        line[line_length] = '\0';
+        handle_line(line);
+        line_length = 0;
+        return;
+    }
+    line[line_length++] = (char)value;
+}
+
+static void gpior0_write(avr_t* avr, avr_io_addr_t address, uint8_t value, void* param) {
+    (void)param;
+    avr->data[address] = value;
+    if (value == BENCHMARK_START) {
+        start_cycle = avr->cycle;
+        running = 1;
+    } else if (value == BENCHMARK_STOP && running && current != NULL) {
+        uint64_t cycles = avr->cycle - start_cycle;
+        running = 0;
+        current->iterations++;
+        current->total += cycles;
+        current->min = cycles < current->min ? cycles : current->min;
+        current->max = cycles > current->max ? cycles : current->max;
+    } else if (value == BENCHMARK_DONE) {
+        done = 1;
+    }
+}
+
+static void write_json(FILE* output, uint64_t baseline) {
+    fprintf(output, "{\n  \"mcu\": \"%s\",\n  \"frequency\": %d,\n  \"frame_cycles\": %lu,\n", MCU, FREQUENCY,
+            frame_cycles);
+    fprintf(output, "  \"baseline_cycles\": %llu,\n  \"benchmarks\": [\n", (unsigned long long)baseline);
+    for (int i = 0; i < number_of_benchmarks; i++) {
+        benchmark_t* benchmark = &benchmarks[i];
+        uint64_t min = benchmark->min - baseline;
+        uint64_t max = benchmark->max - baseline;
+        double mean = (double)benchmark->total / benchmark->iterations - baseline;
+        fprintf(output,
+                "    {\"name\": \"%s\", \"iterations\": %lu, \"min\": %llu, \"mean\": %.1f, \"max\": %llu, "
+                "\"frame_percent\": %.2f}%s\n",
+                benchmark->name, benchmark->iterations, (unsigned long long)min, mean, (unsigned long long)max,
+                frame_cycles ? 100.0 * max / frame_cycles : 0.0, i + 1 < number_of_benchmarks ? "," : "");
+    }
+    fprintf(output, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    const char* output_path = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "o:")) != -1) {
+        if (option != 'o') {
+            fprintf(stderr, "usage: %s [-o output.json] firmware.elf\n", argv[0]);
+            return 2;
+        }
+        output_path = optarg;
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "usage: %s [-o output.json] firmware.elf\n", argv[0]);
+        return 2;
+    }
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+    if (elf_read_firmware(argv[optind], &firmware) != 0) {
+        fprintf(stderr, "cannot read %s\n", argv[optind]);
+        return 1;
+    }
+    avr_t* avr = avr_make_mcu_by_name(MCU);
+    if (avr == NULL) {
+        fprintf(stderr, "simavr does not know %s\n", MCU);
+        return 1;
+    }
+    avr_init(avr);
+    firmware.frequency = FREQUENCY;
+    avr_load_firmware(avr, &firmware);
+
+    uint32_t flags = 0;
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+    flags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), uart_output, NULL);
+    avr_register_io_write(avr, GPIOR0_ADDRESS, gpior0_write, NULL);
+
+    ds3231_t rtc;
+    ds3231_init(avr, &rtc, 12, 0, 0);
+    ds3231_attach(avr, &rtc, 0);
+
+    int state = cpu_Running;
+    while (!done && state != cpu_Done && state != cpu_Crashed && avr->cycle < MAX_CYCLES) {
+        state = avr_run(avr);
+    }
+    if (!done) {
+        fprintf(stderr, "firmware did not finish the benchmarks (state %d, cycle %llu)\n", state,
+                (unsigned long long)avr->cycle);
+        return 1;
+    }
+    if (number_of_benchmarks == 0 || strcmp(benchmarks[0].name, BASELINE_NAME) != 0) {
+        fprintf(stderr, "first benchmark has to be \"%s\"\n", BASELINE_NAME);
+        return 1;
+    }
+
+    for (int i = 0; i < number_of_benchmarks; i++) {
+        fprintf(stderr, "%-20s %8llu %8llu cycles\n", benchmarks[i].name,
+                (unsigned long long)(benchmarks[i].min - benchmarks[0].min),
+                (unsigned long long)(benchmarks[i].max - benchmarks[0].min));
+    }
+    fprintf(stderr, "rtc transactions: %lu\n", rtc.transactions);
+
+    FILE* output = output_path != NULL ? fopen(output_path, "w") : stdout;
+    if (output == NULL) {
+        perror(output_path);
+        return 1;
+    }
+    write_json(output, benchmarks[0].min);
+    if (output != stdout) {
+        fclose(output);
+    }
+    avr_terminate(avr);
+    return 0;
+}
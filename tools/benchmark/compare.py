@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""Porovná dva výsledky tools/benchmark, například z různých commitů.
+
+    compare.py PŘED.json PO.json [--threshold PROCENT]
+
+Vypíše nejdelší běh (max) každého měření v cyklech a jeho změnu. Pokud se některé měření
+zpomalí o víc než threshold procent (výchozí 1 %), skončí s návratovým kódem 1.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as file:
+        return {benchmark["name"]: benchmark for benchmark in json.load(file)["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("before")
+    parser.add_argument("after")
+    parser.add_argument("--threshold", type=float, default=1.0)
+    arguments = parser.parse_args()
+    before, after = load(arguments.before), load(arguments.after)
+    regression = False
+    print("%-20s %10s %10s %8s" % ("benchmark", "before", "after", "change"))
+    for name in list(before) + [name for name in after if name not in before]:
+        if name not in before or name not in after:
+            print("%-20s %10s %10s" % (name, before.get(name, {}).get("max", "-"), after.get(name, {}).get("max", "-")))
+            continue
+        old, new = before[name]["max"], after[name]["max"]
+        change = 100.0 * (new - old) / old if old else 0.0
+        regression |= change > arguments.threshold
+        print("%-20s %10d %10d %+7.1f%%" % (name, old, new, change))
+    return 1 if regression else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,104 @@
+#include "ds3231.h"
+
+#include <string.h>
+
+#include <simavr/avr_twi.h>
+#include <simavr/sim_time.h>
+
+#define SECONDS_REGISTER 0x00
+#define MINUTES_REGISTER 0x01
+#define HOURS_REGISTER 0x02
+#define DAY_REGISTER 0x03
+#define STATUS_REGISTER 0x0F
+#define STATUS_OSF 0x80
+
+static const char* irq_names[2] = {
+    [TWI_IRQ_INPUT] = "8>ds3231.in",
+    [TWI_IRQ_OUTPUT] = "8<ds3231.out",
+};
+
+static uint8_t to_bcd(uint8_t value) {
+    return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+/* Přičte jedničku k BCD registru, při přetečení přes max vrátí 1 a registr vynuluje */
+static int increment_bcd(uint8_t* value, uint8_t max) {
+    uint8_t next = *value + 1;
+    if ((next & 0x0F) > 9) {
+        next = (uint8_t)((next & 0xF0) + 0x10);
+    }
+    if (next > max) {
+        *value = 0;
+        return 1;
+    }
+    *value = next;
+    return 0;
+}
+
+static avr_cycle_count_t second_elapsed(avr_t* avr, avr_cycle_count_t when, void* param) {
+    ds3231_t* rtc = param;
+    if (increment_bcd(&rtc->registers[SECONDS_REGISTER], 0x59) &&
+        increment_bcd(&rtc->registers[MINUTES_REGISTER], 0x59) &&
+        increment_bcd(&rtc->registers[HOURS_REGISTER], 0x23)) {
+        rtc->registers[DAY_REGISTER] = rtc->registers[DAY_REGISTER] % 7 + 1;
+    }
+    return when + avr_usec_to_cycles(avr, 1000000);
+}
+
+/*
+ * Zpráva ze sběrnice: START s adresou vybere čip, první zapsaný bajt je adresa registru,
+ * další zápisy a čtení registry postupně procházejí.
+ */
+static void twi_message(avr_irq_t* irq, uint32_t value, void* param) {
+    ds3231_t* rtc = param;
+    avr_twi_msg_irq_t message;
+    message.u.v = value;
+    (void)irq;
+
+    if (message.u.twi.msg & TWI_COND_STOP) {
+        rtc->selected = 0;
+    }
+    if (message.u.twi.msg & TWI_COND_START) {
+        rtc->selected = (message.u.twi.addr >> 1) == DS3231_I2C_ADDRESS;
+        rtc->address_written = 0;
+        if (rtc->selected) {
+            rtc->transactions++;
+            avr_raise_irq(rtc->irq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, message.u.twi.addr, 1));
+        }
+    }
+    if (!rtc->selected) {
+        return;
+    }
+    if (message.u.twi.msg & TWI_COND_WRITE) {
+        avr_raise_irq(rtc->irq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, message.u.twi.addr, 1));
+        if (!rtc->address_written) {
+            rtc->address = message.u.twi.data % DS3231_NUMBER_OF_REGISTERS;
+            rtc->address_written = 1;
+        } else {
+            rtc->registers[rtc->address] = message.u.twi.data;
+            rtc->address = (rtc->address + 1) % DS3231_NUMBER_OF_REGISTERS;
+        }
+    }
+    if (message.u.twi.msg & TWI_COND_READ) {
+        uint8_t data = rtc->registers[rtc->address];
+        rtc->address = (rtc->address + 1) % DS3231_NUMBER_OF_REGISTERS;
+        avr_raise_irq(rtc->irq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_READ, message.u.twi.addr, data));
+    }
+}
+
+void ds3231_init(avr_t* avr, ds3231_t* rtc, uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    memset(rtc, 0, sizeof(*rtc));
+    rtc->irq = avr_alloc_irq(&avr->irq_pool, 0, 2, irq_names);
+    avr_irq_register_notify(rtc->irq + TWI_IRQ_OUTPUT, twi_message, rtc);
+    rtc->registers[SECONDS_REGISTER] = to_bcd(seconds);
+    rtc->registers[MINUTES_REGISTER] = to_bcd(minutes);
+    rtc->registers[HOURS_REGISTER] = to_bcd(hours);
+    rtc->registers[DAY_REGISTER] = 1;
+    rtc->registers[STATUS_REGISTER] = 0;
+    avr_cycle_timer_register_usec(avr, 1000000, second_elapsed, rtc);
+}
+
+void ds3231_attach(avr_t* avr, ds3231_t* rtc, uint32_t twi) {
+    avr_connect_irq(rtc->irq + TWI_IRQ_INPUT, avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(twi), TWI_IRQ_INPUT));
+    avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(twi), TWI_IRQ_OUTPUT), rtc->irq + TWI_IRQ_OUTPUT);
+}
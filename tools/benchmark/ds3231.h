@@ -0,0 +1,29 @@
+/*
+ * Model čipu reálného času DS3231 na sběrnici I2C (TWI) simulátoru simavr.
+ * Umí registry času, alarmů, řízení a stavu s automatickým posunem adresy registru
+ * a každou sekundu simulace posune čas. Alarmy ani pin INT nemodeluje.
+ */
+#ifndef DS3231_H
+#define DS3231_H
+
+#include <stdint.h>
+
+#include <simavr/sim_avr.h>
+#include <simavr/sim_irq.h>
+
+#define DS3231_I2C_ADDRESS 0x68
+#define DS3231_NUMBER_OF_REGISTERS 0x13
+
+typedef struct ds3231_t {
+    avr_irq_t* irq;
+    uint8_t registers[DS3231_NUMBER_OF_REGISTERS];
+    uint8_t address;
+    int selected;
+    int address_written;
+    unsigned long transactions;
+} ds3231_t;
+
+void ds3231_init(avr_t* avr, ds3231_t* rtc, uint8_t hours, uint8_t minutes, uint8_t seconds);
+void ds3231_attach(avr_t* avr, ds3231_t* rtc, uint32_t twi);
+
+#endif
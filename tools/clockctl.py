@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""Nastavení hodin po sériové lince binárním protokolem (src/protocol/protocol.hpp).
+
+Funguje se skutečnou deskou i se simulátorem spuštěným s --pty, potřebuje jen standardní knihovnu.
+
+    clockctl.py PORT time [HH:MM:SS | now]
+    clockctl.py PORT alarm [HH:MM on|off]
+    clockctl.py PORT config [HH:MM on|off SNOOZE [HH:MM:SS | now]]
+    clockctl.py PORT telemetry
+    clockctl.py PORT memory
+    clockctl.py PORT trace > zaznam.txt
+
+Výpis záznamu událostí (trace) přehraje simulátor: .pio/build/native/program --replay zaznam.txt
+"""
+import datetime
+import os
+import select
+import sys
+import termios
+import time
+
+START_BYTE = 0x7E
+RESPONSE_FLAG = 0x80
+TIMEOUT_SECONDS = 1.0
+
+SET_TIME = 0x01
+GET_TIME = 0x02
+SET_ALARM = 0x03
+GET_ALARM = 0x04
+GET_TELEMETRY = 0x05
+SET_CONFIG = 0x06
+GET_CONFIG = 0x07
+GET_MEMORY = 0x08
+GET_FOOTPRINT = 0x09
+GET_TRACE = 0x0A
+GET_TRACE_RECORD = 0x0B
+
+STATUS_NAMES = ["ok", "unknown command", "bad length", "bad value"]
+UI_STATES = ["clock", "set time hours", "set time minutes", "set alarm hours", "set alarm minutes", "set snooze",
+             "temperature", "alarm status"]
+
+# Názvy ve výpisu záznamu událostí, stejné čte přepínač --replay simulátoru (src/sim/simMain.cpp)
+TRACE_TIME_SHIFT = 6
+TRACE_BUTTON, TRACE_RTC, TRACE_TIME_SET, TRACE_UI, TRACE_ALARM = range(1, 6)
+TRACE_BUTTONS = ["set", "plus", "minus", "alarm", "snooze"]
+TRACE_EVENTS = TRACE_BUTTONS + ["plus-repeat", "minus-repeat", "plus-fast", "minus-fast", "long-press", "chord"]
+TRACE_STATES = ["clock", "time-hours", "time-minutes", "alarm-hours", "alarm-minutes", "snooze", "temperature",
+                "alarm-status"]
+TRACE_ALARMS = ["ring", "snooze", "off"]
+BUTTON_EVENT_RELEASED = 0x80
+TRACE_UI_TIMEOUT = 0xFF
+
+
+def crc8(data):
+    """CRC-8 s polynomem 0x31, stejné jako crc8 v src/crc/crc.cpp."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x31) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def open_port(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    attributes = termios.tcgetattr(fd)
+    attributes[0] = 0  # iflag
+    attributes[1] = 0  # oflag
+    attributes[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attributes[3] = 0  # lflag
+    attributes[4] = attributes[5] = termios.B9600
+    termios.tcsetattr(fd, termios.TCSANOW, attributes)
+    return fd
+
+
+def read_byte(fd, deadline):
+    remaining = deadline - time.monotonic()
+    if remaining <= 0 or not select.select([fd], [], [], remaining)[0]:
+        raise TimeoutError("no response")
+    return os.read(fd, 1)[0]
+
+
+def request(fd, command, payload=b""):
+    """Pošle příkaz a vrátí data odpovědi, text (výpis profileru) mezi rámci přeskočí."""
+    body = bytes([len(payload), command]) + bytes(payload)
+    os.write(fd, bytes([START_BYTE]) + body + bytes([crc8(body)]))
+    deadline = time.monotonic() + TIMEOUT_SECONDS
+    while True:
+        if read_byte(fd, deadline) != START_BYTE:
+            continue
+        length = read_byte(fd, deadline)
+        response = bytes([length] + [read_byte(fd, deadline) for _ in range(length + 2)])
+        if crc8(response[:-1]) != response[-1] or response[1] != command | RESPONSE_FLAG or length < 1:
+            continue
+        status = response[2]
+        if status != 0:
+            name = STATUS_NAMES[status] if status < len(STATUS_NAMES) else str(status)
+            raise RuntimeError("clock refused command: " + name)
+        return response[3:-1]
+
+
+def parse_time(text):
+    if text == "now":
+        now = datetime.datetime.now()
+        return [now.hour, now.minute, now.second]
+    parts = [int(part) for part in text.split(":")]
+    return parts + [0] * (3 - len(parts))
+
+
+def parse_on(text):
+    if text not in ("on", "off"):
+        raise ValueError("expected on or off")
+    return 1 if text == "on" else 0
+
+
+def name(names, index):
+    return names[index] if index < len(names) else str(index)
+
+
+def format_trace_record(record_type, data):
+    """Jeden záznam událostí jako text bez času, None pro neznámý nebo prázdný záznam."""
+    if record_type == TRACE_BUTTON:
+        action = "release" if data[0] & BUTTON_EVENT_RELEASED else "press"
+        return "button %s %s" % (action, name(TRACE_BUTTONS, data[0] & ~BUTTON_EVENT_RELEASED))
+    if record_type in (TRACE_RTC, TRACE_TIME_SET):
+        return "%s %02d:%02d:%02d" % (("rtc" if record_type == TRACE_RTC else "time-set",) + tuple(data))
+    if record_type == TRACE_UI:
+        event = "timeout" if data[2] == TRACE_UI_TIMEOUT else name(TRACE_EVENTS, data[2])
+        return "ui %s %s %s" % (name(TRACE_STATES, data[0]), name(TRACE_STATES, data[1]), event)
+    if record_type == TRACE_ALARM:
+        return "alarm %s %d" % (name(TRACE_ALARMS, data[0]), data[1])
+    return None
+
+
+def dump_trace(fd):
+    """Vypíše záznam událostí, časy v sekundách od prvního záznamu, 16bitový čas záznamů se rozbalí."""
+    hours, mins, on, snooze = request(fd, GET_CONFIG)
+    data = request(fd, GET_TRACE)
+    count, length, now = int.from_bytes(data[0:2], "little"), data[2], int.from_bytes(data[3:5], "little")
+    records = []
+    for sequence in range(count - length, count):
+        try:
+            record = request(fd, GET_TRACE_RECORD, (sequence & 0xFFFF).to_bytes(2, "little"))
+        except RuntimeError:
+            # záznam mezitím přepsala novější událost
+            continue
+        text = format_trace_record(record[2], record[3:6])
+        if text is not None:
+            records.append((int.from_bytes(record[0:2], "little"), text))
+    print("# %d records of %d events" % (len(records), count))
+    print("config %02d:%02d %s %d" % (hours, mins, "on" if on else "off", snooze))
+    if not records:
+        return
+    units = 0
+    previous = records[0][0]
+    for stamp, text in records:
+        units += (stamp - previous) & 0xFFFF
+        previous = stamp
+        print("%.3f %s" % ((units << TRACE_TIME_SHIFT) / 1000, text))
+    print("# last record %.1f s ago" % ((((now - previous) & 0xFFFF) << TRACE_TIME_SHIFT) / 1000))
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+    fd = open_port(argv[1])
+    command, arguments = argv[2], argv[3:]
+    if command == "time":
+        if arguments:
+            request(fd, SET_TIME, parse_time(arguments[0]))
+        print("%02d:%02d:%02d" % tuple(request(fd, GET_TIME)))
+    elif command == "alarm":
+        if arguments:
+            request(fd, SET_ALARM, parse_time(arguments[0])[:2] + [parse_on(arguments[1])])
+        hours, mins, on = request(fd, GET_ALARM)
+        print("%02d:%02d %s" % (hours, mins, "on" if on else "off"))
+    elif command == "config":
+        if arguments:
+            payload = parse_time(arguments[0])[:2] + [parse_on(arguments[1]), int(arguments[2])]
+            if len(arguments) > 3:
+                payload += parse_time(arguments[3])
+            request(fd, SET_CONFIG, payload)
+        hours, mins, on, snooze = request(fd, GET_CONFIG)
+        print("alarm %02d:%02d %s, snooze %d min" % (hours, mins, "on" if on else "off", snooze))
+    elif command == "telemetry":
+        data = request(fd, GET_TELEMETRY)
+        state = name(UI_STATES, data[5])
+        print("uptime:      %.3f s" % (int.from_bytes(data[0:4], "little") / 1000))
+        print("brightness:  %d" % data[4])
+        print("ui state:    %s" % state)
+        print("alarm:       %s" % ("ringing" if data[6] else "snoozed" if data[7] else "idle"))
+        print("bad frames:  %d" % int.from_bytes(data[8:10], "little"))
+        drift = int.from_bytes(data[10:12], "little", signed=True)
+        minutes = data[12]
+        resyncs = int.from_bytes(data[13:15], "little")
+        if resyncs == 0:
+            print("drift:       not measured yet")
+        else:
+            ppm = drift * 1e6 / (minutes * 60) if minutes else 0.0
+            print("drift:       %+d s in %d min (%+.0f ppm), %d resyncs" % (drift, minutes, ppm, resyncs))
+    elif command == "memory":
+        data = request(fd, GET_MEMORY)
+        static_bytes, free_bytes, headroom, threshold = [int.from_bytes(data[i:i + 2], "little") for i in range(0, 8, 2)]
+        print("static data: %d B" % static_bytes)
+        print("free:        %d B" % free_bytes)
+        print("headroom:    %d B (threshold %d B%s)" % (headroom, threshold, ", LOW" if data[8] else ""))
+        for index in range(data[9]):
+            footprint = request(fd, GET_FOOTPRINT, [index])
+            print("  %-10s %5d B" % (footprint[2:].decode("ascii"), int.from_bytes(footprint[0:2], "little")))
+    elif command == "trace":
+        dump_trace(fd)
+    else:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))